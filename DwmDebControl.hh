@@ -46,7 +46,7 @@
 #include <string>
 #include <set>
 
-#include "DwmDebPkgDepend.hh"
+#include "DwmDebDependSet.hh"
 
 namespace Dwm {
 
@@ -60,6 +60,11 @@ namespace Dwm {
     public:
       Control();
     
+      //----------------------------------------------------------------------
+      //!  Parses the control file at @c path into this object.  Each call
+      //!  has its own scanner and parser state, so distinct Control
+      //!  objects may be parsed concurrently.  Returns true on success.
+      //----------------------------------------------------------------------
       bool Parse(const std::string & path);
 
       bool HasRequiredEntries() const;
@@ -67,36 +72,42 @@ namespace Dwm {
       const std::map<std::string,std::string> & Entries() const
       { return _entries; }
 
-      const std::set<PkgDepend> & Depends() const
+      const DependSet & Depends() const
       { return _depends; }
       
-      const std::set<PkgDepend> & PreDepends() const
+      const DependSet & PreDepends() const
       { return _predepends;
       }
       
       void Add(const std::pair<std::string,std::string> & entry);
 
-      std::set<PkgDepend>::const_iterator
-      RemoveDepend(const PkgDepend & dep);
+      bool RemoveDepend(const std::string & pkg);
 
-      std::set<PkgDepend>::const_iterator
-      RemovePreDepend(const PkgDepend & dep);
+      bool RemovePreDepend(const std::string & pkg);
 
-      void AddDepend(const PkgDepend & dep);
+      //----------------------------------------------------------------------
+      //!  Adds @c dep to Depends, narrowing any existing dependency on the
+      //!  same package.  Returns false if that leaves no acceptable
+      //!  version of the package.
+      //----------------------------------------------------------------------
+      bool AddDepend(const PkgDepend & dep);
 
-      void AddPreDepend(const PkgDepend & dep);
+      //----------------------------------------------------------------------
+      //!  Like AddDepend(), for Pre-Depends.
+      //----------------------------------------------------------------------
+      bool AddPreDepend(const PkgDepend & dep);
       
-      void AddDepends(const std::set<PkgDepend> & depends);
+      bool AddDepends(const std::set<PkgDepend> & depends);
 
-      void AddPreDepends(const std::set<PkgDepend> & depends);
+      bool AddPreDepends(const std::set<PkgDepend> & depends);
     
       friend std::ostream & operator << (std::ostream & os,
                                          const Control & debctrl);
 
     private:
       std::map<std::string,std::string>  _entries;
-      std::set<PkgDepend>                _predepends;
-      std::set<PkgDepend>                _depends;
+      DependSet                          _predepends;
+      DependSet                          _depends;
     };
 
   }  // namespace Deb
@@ -41,6 +41,7 @@
   //!  \brief Debian control file parser
   //-------------------------------------------------------------------------
 
+  #include <cstdio>
   #include <iostream>
   #include <string>
   #include <utility>
@@ -51,18 +52,18 @@
   #include "DwmDebPkgVersion.hh"
     
   using std::pair, std::string, std::set;
+
+  //  The reentrant scanner's handle, as flex declares it.
+  #ifndef YY_TYPEDEF_YY_SCANNER_T
+  #define YY_TYPEDEF_YY_SCANNER_T
+  typedef void *yyscan_t;
+  #endif
 }
 
 %{
   #include <cstdio>
   #include <cstdlib>
     
-  extern "C" {
-    extern void dwmdebctrlerror(const char *arg, ...);
-    extern FILE *dwmdebctrlin;
-  }
-
-  #include <mutex>
   #include <string>
 
   #include "DwmDebControl.hh"
@@ -70,13 +71,12 @@
 
   using namespace std;
   
-  string              g_debPath;
-  Dwm::Deb::Control  *g_debctrl = nullptr;
-  static mutex      g_mtx;
-  
 %}
 
 %define api.prefix {dwmdebctrl}
+%define api.pure full
+%param {yyscan_t scanner}
+%parse-param {Dwm::Deb::Control & debctrl}
 
 %union {
   string                    *stringVal;
@@ -89,11 +89,20 @@
 %code provides
 {
   // Tell Flex the expected prototype of yylex.
-  #define YY_DECL                             \
-    int dwmdebctrllex ()
+  #define YY_DECL                                                       \
+    int dwmdebctrllex(DWMDEBCTRLSTYPE *lval, yyscan_t yyscanner)
 
   // Declare the scanner.
   YY_DECL;
+
+  //  Scanner lifecycle, from the reentrant flex scanner.
+  int dwmdebctrllex_init_extra(const std::string *path, yyscan_t *scanner);
+  void dwmdebctrlset_in(FILE *f, yyscan_t scanner);
+  int dwmdebctrllex_destroy(yyscan_t scanner);
+
+  //  Reports a syntax error.  Defined with the scanner.
+  void dwmdebctrlerror(yyscan_t scanner, Dwm::Deb::Control & debctrl,
+                       const char *msg);
 }
 
 %token DEPENDS PREDEPENDS
@@ -109,34 +118,34 @@
 
 Fields: Field
 {
-  g_debctrl->Add(*$1);
+  debctrl.Add(*$1);
   //  std::cout << $1->first << " " << $1->second  << '\n';
   delete $1;
 }
 | Depends
 {
-  g_debctrl->AddDepends(*$1);
+  debctrl.AddDepends(*$1);
   delete $1;
 }
 | PreDepends
 {
-  g_debctrl->AddDepends(*$1);
+  debctrl.AddPreDepends(*$1);
   delete $1;
 }
 | Fields Field
 {
-  g_debctrl->Add(*$2);
+  debctrl.Add(*$2);
   //  std::cout << $2->first << " " << $2->second << '\n';
   delete $2;
 }
 | Fields Depends
 {
-  g_debctrl->AddDepends(*$2);
+  debctrl.AddDepends(*$2);
   delete $2;
 }
 | Fields PreDepends
 {
-  g_debctrl->AddPreDepends(*$2);
+  debctrl.AddPreDepends(*$2);
   delete $2;
 };
 
@@ -251,15 +260,16 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool Control::Parse(const string & path)
     {
-      lock_guard<mutex>  lck(g_mtx);
-      
       bool  rc = false;
-      dwmdebctrlin = fopen(path.c_str(), "r");
-      if (dwmdebctrlin) {
-        g_debPath = path;
-        g_debctrl = this;
-        rc = (0 == dwmdebctrlparse());
-        fclose(dwmdebctrlin);
+      FILE  *f = fopen(path.c_str(), "r");
+      if (f) {
+        yyscan_t  scanner;
+        if (0 == dwmdebctrllex_init_extra(&path, &scanner)) {
+          dwmdebctrlset_in(f, scanner);
+          rc = (0 == dwmdebctrlparse(scanner, *this));
+          dwmdebctrllex_destroy(scanner);
+        }
+        fclose(f);
       }
       return rc;
     }
@@ -297,65 +307,57 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    std::set<PkgDepend>::const_iterator
-    Control::RemoveDepend(const PkgDepend & dep)
+    bool Control::RemoveDepend(const string & pkg)
     {
-      auto  it = _depends.find(dep);
-      if (it != _depends.end()) {
-        it = _depends.erase(it);
-      }
-      return it;
+      return _depends.Remove(pkg);
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    std::set<PkgDepend>::const_iterator
-    Control::RemovePreDepend(const PkgDepend & dep)
+    bool Control::RemovePreDepend(const string & pkg)
     {
-      auto  it = _predepends.find(dep);
-      if (it != _predepends.end()) {
-        it = _predepends.erase(it);
-      }
-      return it;
+      return _predepends.Remove(pkg);
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    void Control::AddDepend(const PkgDepend & dep)
+    bool Control::AddDepend(const PkgDepend & dep)
     {
-      _depends.insert(dep);
+      return _depends.Add(dep);
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    void Control::AddPreDepend(const PkgDepend & dep)
+    bool Control::AddPreDepend(const PkgDepend & dep)
     {
-      _predepends.insert(dep);
+      return _predepends.Add(dep);
     }
   
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    void Control::AddDepends(const std::set<PkgDepend> & depends)
+    bool Control::AddDepends(const std::set<PkgDepend> & depends)
     {
+      bool  rc = true;
       for (const auto & d : depends) {
-        _depends.insert(d);
+        rc &= _depends.Add(d);
       }
-      return;
+      return rc;
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    void Control::AddPreDepends(const std::set<PkgDepend> & depends)
+    bool Control::AddPreDepends(const std::set<PkgDepend> & depends)
     {
+      bool  rc = true;
       for (const auto & d : depends) {
-        _predepends.insert(d);
+        rc &= _predepends.Add(d);
       }
-      return;
+      return rc;
     }
 
     //------------------------------------------------------------------------
@@ -368,23 +370,11 @@ namespace Dwm {
         os << e.first << ' ' << e.second << '\n';
       }
       if (! debctrl._predepends.empty()) {
-        os << "Pre-Depends: ";
-        string sep;
-        for (const auto & predep : debctrl._predepends) {
-          os << sep << predep;
-          sep = ", ";
-        }
-        os << '\n';
+        os << "Pre-Depends: " << debctrl._predepends << '\n';
       }
 
       if (! debctrl._depends.empty()) {
-        os << "Depends: ";
-        string sep;
-        for (const auto & dep : debctrl._depends) {
-          os << sep << dep;
-          sep = ", ";
-        }
-        os << '\n';
+        os << "Depends: " << debctrl._depends << '\n';
       }
       return os;
     }
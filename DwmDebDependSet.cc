@@ -0,0 +1,220 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebDependSet.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::VersionRange and Dwm::Deb::DependSet class
+//!    implementations
+//---------------------------------------------------------------------------
+
+#include "DwmDebDependSet.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    VersionRange::VersionRange()
+        : _lower{false, false, PkgVersion()},
+          _upper{false, false, PkgVersion()}
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool VersionRange::Intersect(const string & op,
+                                 const PkgVersion & version)
+    {
+      bool  lower = false, upper = false, inclusive = true;
+      if ((op == ">=") || (op == ">")) {
+        lower = true;
+      }
+      else if (op == ">>") {
+        lower = true;
+        inclusive = false;
+      }
+      else if ((op == "<=") || (op == "<")) {
+        upper = true;
+      }
+      else if (op == "<<") {
+        upper = true;
+        inclusive = false;
+      }
+      else if (op == "=") {
+        lower = upper = true;
+      }
+      else {
+        return false;
+      }
+      if (lower) {
+        int  c = (_lower.isSet ? version.Compare(_lower.version) : 1);
+        if (c > 0) {
+          _lower = { true, inclusive, version };
+        }
+        else if (c == 0) {
+          _lower.inclusive = (_lower.inclusive && inclusive);
+        }
+      }
+      if (upper) {
+        int  c = (_upper.isSet ? version.Compare(_upper.version) : -1);
+        if (c < 0) {
+          _upper = { true, inclusive, version };
+        }
+        else if (c == 0) {
+          _upper.inclusive = (_upper.inclusive && inclusive);
+        }
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool VersionRange::IsEmpty() const
+    {
+      bool  rc = false;
+      if (_lower.isSet && _upper.isSet) {
+        int  c = _lower.version.Compare(_upper.version);
+        rc = ((c > 0)
+              || ((c == 0) && ! (_lower.inclusive && _upper.inclusive)));
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void VersionRange::Relations(const string & pkg,
+                                 vector<PkgDepend> & deps) const
+    {
+      if (_lower.isSet && _upper.isSet && _lower.inclusive
+          && _upper.inclusive && (_lower.version == _upper.version)) {
+        deps.push_back(PkgDepend(pkg, "=", _lower.version));
+        return;
+      }
+      if (_lower.isSet) {
+        deps.push_back(PkgDepend(pkg, (_lower.inclusive ? ">=" : ">>"),
+                                 _lower.version));
+      }
+      if (_upper.isSet) {
+        deps.push_back(PkgDepend(pkg, (_upper.inclusive ? "<=" : "<<"),
+                                 _upper.version));
+      }
+      if ((! _lower.isSet) && (! _upper.isSet)) {
+        deps.push_back(PkgDepend(pkg));
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool DependSet::Add(const PkgDepend & dep)
+    {
+      VersionRange  range;
+      auto  it = _ranges.find(dep.Package());
+      if (it != _ranges.end()) {
+        range = it->second;
+      }
+      if ((! dep.Operator().empty())
+          && (! range.Intersect(dep.Operator(), dep.Version()))) {
+        return false;
+      }
+      _ranges[dep.Package()] = range;
+      return (! range.IsEmpty());
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool DependSet::Remove(const string & pkg)
+    {
+      return (_ranges.erase(pkg) > 0);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool DependSet::Find(const string & pkg, VersionRange & range) const
+    {
+      auto  it = _ranges.find(pkg);
+      if (it != _ranges.end()) {
+        range = it->second;
+        return true;
+      }
+      return false;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool DependSet::Unsatisfiable(vector<string> & pkgs) const
+    {
+      bool  rc = false;
+      for (const auto & [pkg, range] : _ranges) {
+        if (range.IsEmpty()) {
+          pkgs.push_back(pkg);
+          rc = true;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ostream & operator << (ostream & os, const DependSet & deps)
+    {
+      string             sep;
+      vector<PkgDepend>  relations;
+      for (const auto & [pkg, range] : deps._ranges) {
+        relations.clear();
+        range.Relations(pkg, relations);
+        for (const auto & rel : relations) {
+          os << sep << rel;
+          sep = ", ";
+        }
+      }
+      return os;
+    }
+
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,161 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebDependSet.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::VersionRange and Dwm::Deb::DependSet class
+//!    declarations
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBDEPENDSET_HH_
+#define _DWMDEBDEPENDSET_HH_
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DwmDebPkgDepend.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  The range of versions of a package allowed by a set of version
+    //!  relations (>=, >>, <=, <<, =), as an optional lower and an
+    //!  optional upper bound, each inclusive or exclusive.  Adding a
+    //!  relation intersects it with the range, so the range only ever
+    //!  shrinks.
+    //------------------------------------------------------------------------
+    class VersionRange
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Constructs an unbounded range (an unversioned dependency).
+      //----------------------------------------------------------------------
+      VersionRange();
+
+      //----------------------------------------------------------------------
+      //!  Intersects the range with the versions satisfying @c op
+      //!  @c version.  The obsolete '>' and '<' mean '>=' and '<=', as
+      //!  they do to dpkg.  Returns false if @c op isn't a relation.
+      //----------------------------------------------------------------------
+      bool Intersect(const std::string & op, const PkgVersion & version);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if no version satisfies the range.
+      //----------------------------------------------------------------------
+      bool IsEmpty() const;
+
+      //----------------------------------------------------------------------
+      //!  Appends to @c deps the fewest relations on @c pkg that express
+      //!  the range: none (an unversioned dependency), one, or a lower
+      //!  and an upper bound.
+      //----------------------------------------------------------------------
+      void Relations(const std::string & pkg,
+                     std::vector<PkgDepend> & deps) const;
+
+    private:
+      struct Bound
+      {
+        bool        isSet;
+        bool        inclusive;
+        PkgVersion  version;
+      };
+
+      Bound  _lower;
+      Bound  _upper;
+    };
+
+    //------------------------------------------------------------------------
+    //!  Dependencies for a Depends or Pre-Depends field, kept as one
+    //!  VersionRange per package.  Adding a dependency on a package that's
+    //!  already present narrows its range instead of adding another entry,
+    //!  so each package is written out with the fewest relations.
+    //------------------------------------------------------------------------
+    class DependSet
+    {
+    public:
+      typedef std::map<std::string,VersionRange>  Map;
+
+      //----------------------------------------------------------------------
+      //!  Adds @c dep, intersecting it with any existing range for its
+      //!  package.  Returns false if @c dep has an unknown operator (and
+      //!  leaves the set as it was) or leaves no version of the package
+      //!  acceptable.
+      //----------------------------------------------------------------------
+      bool Add(const PkgDepend & dep);
+
+      //----------------------------------------------------------------------
+      //!  Removes the dependency on @c pkg.  Returns false if there was
+      //!  none.
+      //----------------------------------------------------------------------
+      bool Remove(const std::string & pkg);
+
+      //----------------------------------------------------------------------
+      //!  Sets @c range to the range of acceptable versions of @c pkg.
+      //!  Returns false if there's no dependency on @c pkg.
+      //----------------------------------------------------------------------
+      bool Find(const std::string & pkg, VersionRange & range) const;
+
+      //----------------------------------------------------------------------
+      //!  Appends to @c pkgs the packages no version of which would
+      //!  satisfy the dependencies on them.  Returns true if there were
+      //!  any.
+      //----------------------------------------------------------------------
+      bool Unsatisfiable(std::vector<std::string> & pkgs) const;
+
+      bool empty() const                  { return _ranges.empty(); }
+      Map::size_type size() const         { return _ranges.size(); }
+      Map::const_iterator begin() const   { return _ranges.begin(); }
+      Map::const_iterator end() const     { return _ranges.end(); }
+
+      //----------------------------------------------------------------------
+      //!  Prints the relations, separated by ", ".
+      //----------------------------------------------------------------------
+      friend std::ostream & operator << (std::ostream & os,
+                                         const DependSet & deps);
+
+    private:
+      Map  _ranges;
+    };
+
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBDEPENDSET_HH_
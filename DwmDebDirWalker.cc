@@ -0,0 +1,221 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebDirWalker.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::DirWalker class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <sys/sysmacros.h>
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cstring>
+
+#include "DwmDebDirWalker.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //  The kernel's directory entry layout for getdents64(2).
+    struct LinuxDirent64
+    {
+      uint64_t        d_ino;
+      int64_t         d_off;
+      unsigned short  d_reclen;
+      unsigned char   d_type;
+      char            d_name[];
+    };
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static uint64_t StatxDev(const struct statx & stx)
+    {
+      return makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    DirWalker::DirWalker(WorkStealingPool & pool, FileCallback callback)
+        : _pool(pool), _callback(callback), _mtx(), _names(), _dirs(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void DirWalker::Walk(const vector<string> & roots)
+    {
+      for (const auto & root : roots) {
+        struct statx  stx;
+        if (statx(AT_FDCWD, root.c_str(), AT_SYMLINK_NOFOLLOW,
+                  STATX_TYPE|STATX_INO, &stx) == 0) {
+          if (S_ISDIR(stx.stx_mode)) {
+            _pool.Submit([this,root] (unsigned int) { WalkDir(root); });
+          }
+          else if (S_ISREG(stx.stx_mode)) {
+            AddFile(StatxDev(stx), stx.stx_ino, root);
+          }
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    uint64_t DirWalker::Directories() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _dirs;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    uint64_t DirWalker::Files() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _names.size();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string DirWalker::Name(const FileId & id) const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      auto  it = _names.find(id);
+      return ((it != _names.end()) ? it->second : string());
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void DirWalker::WalkDir(const string & path)
+    {
+      int  fd = openat(AT_FDCWD, path.c_str(),
+                       O_RDONLY|O_DIRECTORY|O_NOFOLLOW|O_CLOEXEC);
+      if (fd < 0) {
+        return;
+      }
+      struct statx  dirStx;
+      if (statx(fd, "", AT_EMPTY_PATH, STATX_INO, &dirStx) != 0) {
+        close(fd);
+        return;
+      }
+      uint64_t  dev = StatxDev(dirStx);
+      {
+        lock_guard<mutex>  lck(_mtx);
+        ++_dirs;
+      }
+      
+      string  prefix = path;
+      if (prefix.back() != '/') {
+        prefix += '/';
+      }
+      alignas(LinuxDirent64) char  buf[32768];
+      long                         nread;
+      while ((nread = syscall(SYS_getdents64, fd, buf, sizeof(buf))) > 0) {
+        for (long off = 0; off < nread; ) {
+          const LinuxDirent64  *de = (const LinuxDirent64 *)(buf + off);
+          off += de->d_reclen;
+          const char  *name = de->d_name;
+          if ((name[0] == '.')
+              && ((name[1] == '\0')
+                  || ((name[1] == '.') && (name[2] == '\0')))) {
+            continue;
+          }
+          unsigned char  dtype = de->d_type;
+          uint64_t       ino = de->d_ino;
+          if (dtype == DT_UNKNOWN) {
+            struct statx  stx;
+            if (statx(fd, name, AT_SYMLINK_NOFOLLOW, STATX_TYPE|STATX_INO,
+                      &stx) != 0) {
+              continue;
+            }
+            if (S_ISDIR(stx.stx_mode))      { dtype = DT_DIR; }
+            else if (S_ISREG(stx.stx_mode)) { dtype = DT_REG; }
+            ino = stx.stx_ino;
+          }
+          if (dtype == DT_DIR) {
+            string  child = prefix + name;
+            _pool.Submit([this,child] (unsigned int) { WalkDir(child); });
+          }
+          else if (dtype == DT_REG) {
+            AddFile(dev, ino, prefix + name);
+          }
+        }
+      }
+      close(fd);
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Records @c path as a name for the file, keeping the lexically
+    //!  smallest name if it has several.  The first name found for the
+    //!  file is handed to the callback right away.
+    //------------------------------------------------------------------------
+    void DirWalker::AddFile(uint64_t dev, uint64_t ino, const string & path)
+    {
+      FileId  id(dev, ino);
+      {
+        lock_guard<mutex>  lck(_mtx);
+        auto  [it, added] = _names.emplace(id, path);
+        if (! added) {
+          if (path < it->second) {
+            it->second = path;
+          }
+          return;
+        }
+      }
+      _pool.Submit([this,id,path] (unsigned int worker)
+                   { _callback(path, id, worker); });
+      return;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,139 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebDirWalker.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::DirWalker class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBDIRWALKER_HH_
+#define _DWMDEBDIRWALKER_HH_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DwmDebWorkStealingPool.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  Walks directory trees on a WorkStealingPool, one task per
+    //!  directory, and hands each regular file to a callback.  Linux only:
+    //!  directories are read with getdents64(2) and the d_type and d_ino
+    //!  of each entry are used as-is, so regular files and directories
+    //!  are never stat'ed.  statx(2) is only used for each directory
+    //!  itself (to learn its device) and for entries whose d_type is
+    //!  DT_UNKNOWN.  Symbolic links are not followed.
+    //!
+    //!  Files are fed to the callback as they're found, so examining
+    //!  them overlaps the walk.  Each physical file (device and inode) is
+    //!  passed to the callback at most once per DirWalker, under the first
+    //!  name found for it, along with its FileId.  Which name that is
+    //!  depends on thread timing, so callers that care about names should
+    //!  key their results by FileId and, once the walk is finished, use
+    //!  Name() to get the lexically smallest name found for each file.
+    //!  Each callback runs as its own pool task and receives the worker
+    //!  index of the task.
+    //------------------------------------------------------------------------
+    class DirWalker
+    {
+    public:
+      //  Device and inode.
+      using FileId = std::pair<uint64_t,uint64_t>;
+      
+      using FileCallback =
+        std::function<void(const std::string &, const FileId &,
+                           unsigned int)>;
+      
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      DirWalker(WorkStealingPool & pool, FileCallback callback);
+
+      //----------------------------------------------------------------------
+      //!  Starts walking @c roots, each of which may be a directory or a
+      //!  regular file.  Returns immediately; call Wait() on the pool to
+      //!  wait for the walk (and all callbacks) to finish.
+      //----------------------------------------------------------------------
+      void Walk(const std::vector<std::string> & roots);
+
+      //----------------------------------------------------------------------
+      //!  Starts walking just @c root.
+      //----------------------------------------------------------------------
+      void Walk(const std::string & root)
+      { Walk(std::vector<std::string>{root}); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of directories read so far.
+      //----------------------------------------------------------------------
+      uint64_t Directories() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of distinct regular files found so far.
+      //----------------------------------------------------------------------
+      uint64_t Files() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the lexically smallest name found so far for the file
+      //!  @c id, or an empty string if it hasn't been found.  Once the
+      //!  pool has finished the walk, the choice doesn't depend on thread
+      //!  timing.
+      //----------------------------------------------------------------------
+      std::string Name(const FileId & id) const;
+      
+    private:
+      WorkStealingPool                & _pool;
+      FileCallback                      _callback;
+      mutable std::mutex                _mtx;
+      std::map<FileId,std::string>      _names;
+      uint64_t                          _dirs;
+
+      void WalkDir(const std::string & path);
+      void AddFile(uint64_t dev, uint64_t ino, const std::string & path);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBDIRWALKER_HH_
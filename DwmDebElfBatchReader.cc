@@ -0,0 +1,644 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebElfBatchReader.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ElfBatchReader class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+  #define DWM_HAVE_IO_URING 1
+  extern "C" {
+    #include <linux/io_uring.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+  }
+  #include <cerrno>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "DwmDebElfBatchReader.hh"
+#include "DwmDebElfDefs.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+    using namespace Elf;
+
+    //  Sanity limits on what we'll read for one file.
+    static constexpr uint64_t  k_maxDynamicSize = 1024 * 1024;
+    static constexpr uint64_t  k_maxStrtabSize = 16 * 1024 * 1024;
+    static constexpr uint64_t  k_strtabSlop = 4096;
+
+    //------------------------------------------------------------------------
+    //!  One file in progress.
+    //------------------------------------------------------------------------
+    struct ElfBatchReader::Job
+    {
+      enum Stage { k_header, k_phdrs, k_dynamic, k_strtab };
+      
+      size_t           idx;
+      int              fd;
+      uint64_t         fileSize;
+      Stage            stage;
+      Header           hdr;
+      ProgramHeaders   phdrs;
+      Dynamic          dyn;
+      uint64_t         strBase;
+      uint64_t         offset;
+      vector<uint8_t>  buf;
+
+      void SetRead(uint64_t off, size_t len)
+      {
+        offset = off;
+        buf.resize(len);
+      }
+    };
+    
+#ifdef DWM_HAVE_IO_URING
+    //------------------------------------------------------------------------
+    //!  A bare-bones io_uring instance, driven with the raw system calls
+    //!  so we don't need liburing.  Only IORING_OP_READ is used.
+    //------------------------------------------------------------------------
+    class ElfBatchReader::Ring
+    {
+    public:
+      Ring()
+          : _fd(-1), _sqPtr(MAP_FAILED), _sqSize(0), _cqPtr(MAP_FAILED),
+            _cqSize(0), _sqes((io_uring_sqe *)MAP_FAILED), _sqesSize(0),
+            _pending(0)
+      {}
+
+      ~Ring()
+      {
+        if (_sqes != MAP_FAILED) {
+          munmap(_sqes, _sqesSize);
+        }
+        if ((_cqPtr != MAP_FAILED) && (_cqPtr != _sqPtr)) {
+          munmap(_cqPtr, _cqSize);
+        }
+        if (_sqPtr != MAP_FAILED) {
+          munmap(_sqPtr, _sqSize);
+        }
+        if (_fd >= 0) {
+          close(_fd);
+        }
+      }
+
+      //----------------------------------------------------------------------
+      //!  Sets up the ring and checks that IORING_OP_READ is supported.
+      //----------------------------------------------------------------------
+      bool Init(unsigned int entries)
+      {
+        io_uring_params  params;
+        memset(&params, 0, sizeof(params));
+        _fd = syscall(__NR_io_uring_setup, entries, &params);
+        if (_fd < 0) {
+          return false;
+        }
+        _sqEntries = params.sq_entries;
+        _sqSize = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+        _cqSize = params.cq_off.cqes
+          + (params.cq_entries * sizeof(io_uring_cqe));
+        bool  singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP);
+        if (singleMmap) {
+          _sqSize = _cqSize = max(_sqSize, _cqSize);
+        }
+        _sqPtr = mmap(nullptr, _sqSize, PROT_READ|PROT_WRITE,
+                      MAP_SHARED|MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+        if (_sqPtr == MAP_FAILED) {
+          return false;
+        }
+        if (singleMmap) {
+          _cqPtr = _sqPtr;
+        }
+        else {
+          _cqPtr = mmap(nullptr, _cqSize, PROT_READ|PROT_WRITE,
+                        MAP_SHARED|MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+          if (_cqPtr == MAP_FAILED) {
+            return false;
+          }
+        }
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = (io_uring_sqe *)mmap(nullptr, _sqesSize,
+                                     PROT_READ|PROT_WRITE,
+                                     MAP_SHARED|MAP_POPULATE, _fd,
+                                     IORING_OFF_SQES);
+        if (_sqes == MAP_FAILED) {
+          return false;
+        }
+        char  *sq = (char *)_sqPtr;
+        _sqTail = (unsigned *)(sq + params.sq_off.tail);
+        _sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+        _sqArray = (unsigned *)(sq + params.sq_off.array);
+        char  *cq = (char *)_cqPtr;
+        _cqHead = (unsigned *)(cq + params.cq_off.head);
+        _cqTail = (unsigned *)(cq + params.cq_off.tail);
+        _cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+        _cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+        return SupportsRead();
+      }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      unsigned int Entries() const
+      { return _sqEntries; }
+      
+      //----------------------------------------------------------------------
+      //!  Queues a read; it's submitted on the next call to Enter().
+      //----------------------------------------------------------------------
+      void PrepRead(int fd, void *buf, unsigned int len, uint64_t offset,
+                    uint64_t userData)
+      {
+        unsigned int   tail = *_sqTail;
+        unsigned int   idx = tail & *_sqMask;
+        io_uring_sqe  *sqe = &_sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = (uint64_t)(uintptr_t)buf;
+        sqe->len = len;
+        sqe->off = offset;
+        sqe->user_data = userData;
+        _sqArray[idx] = idx;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++_pending;
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Submits queued reads and waits for at least @c minComplete
+      //!  completions.  EINTR, EAGAIN and EBUSY are transient; we retry
+      //!  them, or return early if there are completions to reap that
+      //!  would let the kernel make progress.
+      //----------------------------------------------------------------------
+      bool Enter(unsigned int minComplete)
+      {
+        for (;;) {
+          int  rc = syscall(__NR_io_uring_enter, _fd, _pending, minComplete,
+                            IORING_ENTER_GETEVENTS, nullptr, 0);
+          if (rc >= 0) {
+            _pending -= min((unsigned int)rc, _pending);
+            return true;
+          }
+          if ((errno == EAGAIN) || (errno == EBUSY)) {
+            if (HaveCompletions()) {
+              return true;
+            }
+            sched_yield();
+          }
+          else if (errno != EINTR) {
+            return false;
+          }
+        }
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of queued reads not yet submitted.
+      //----------------------------------------------------------------------
+      unsigned int Unsubmitted() const
+      { return _pending; }
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if there's a completion waiting to be reaped.
+      //----------------------------------------------------------------------
+      bool HaveCompletions() const
+      {
+        return (*_cqHead != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Pops one completion, if there is one.
+      //----------------------------------------------------------------------
+      bool Reap(uint64_t & userData, int & res)
+      {
+        unsigned int  head = *_cqHead;
+        if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) {
+          return false;
+        }
+        const io_uring_cqe  *cqe = &_cqes[head & *_cqMask];
+        userData = cqe->user_data;
+        res = cqe->res;
+        __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+      }
+      
+    private:
+      int            _fd;
+      void          *_sqPtr;
+      size_t         _sqSize;
+      void          *_cqPtr;
+      size_t         _cqSize;
+      io_uring_sqe  *_sqes;
+      size_t         _sqesSize;
+      unsigned int   _sqEntries;
+      unsigned int  *_sqTail;
+      unsigned int  *_sqMask;
+      unsigned int  *_sqArray;
+      unsigned int  *_cqHead;
+      unsigned int  *_cqTail;
+      unsigned int  *_cqMask;
+      io_uring_cqe  *_cqes;
+      unsigned int   _pending;
+
+      //----------------------------------------------------------------------
+      //!  IORING_OP_READ appeared in Linux 5.6, as did the probe.
+      //----------------------------------------------------------------------
+      bool SupportsRead() const
+      {
+        constexpr unsigned int  numOps = 256;
+        vector<uint8_t>  mem(sizeof(io_uring_probe)
+                             + (numOps * sizeof(io_uring_probe_op)), 0);
+        io_uring_probe  *probe = (io_uring_probe *)mem.data();
+        if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE,
+                    probe, numOps) < 0) {
+          return false;
+        }
+        return ((probe->ops_len > IORING_OP_READ)
+                && (probe->ops[IORING_OP_READ].flags
+                    & IO_URING_OP_SUPPORTED));
+      }
+    };
+#else
+    //  Placeholder so std::unique_ptr<Ring> has a complete type.
+    class ElfBatchReader::Ring {};
+#endif
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ElfBatchReader::Stats &
+    ElfBatchReader::Stats::operator += (const Stats & stats)
+    {
+      files += stats.files;
+      reads += stats.reads;
+      waits += stats.waits;
+      depthSum += stats.depthSum;
+      maxDepth = max(maxDepth, stats.maxDepth);
+      ioUring = ioUring || stats.ioUring;
+      return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ElfBatchReader::ElfBatchReader(bool useIoUring, unsigned int queueDepth)
+        : _ring(), _queueDepth(max(queueDepth, 1U)), _stats()
+    {
+#ifdef DWM_HAVE_IO_URING
+      if (useIoUring) {
+        _ring = make_unique<Ring>();
+        if (_ring->Init(_queueDepth)) {
+          _queueDepth = min(_queueDepth, _ring->Entries());
+        }
+        else {
+          _ring.reset();
+        }
+      }
+#endif
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ElfBatchReader::~ElfBatchReader()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfBatchReader::UsingIoUring() const
+    {
+      return (_ring != nullptr);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ElfBatchReader::Read(const vector<string> & paths,
+                              vector<Result> & results,
+                              CandidateFilter filter)
+    {
+      Result  notDynamic;
+      notDynamic.status = Status::NotDynamic;
+      results.assign(paths.size(), notDynamic);
+      if (_ring) {
+        ReadWithRing(paths, results, filter);
+      }
+      else {
+        ReadWithPread(paths, results, filter);
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ElfBatchReader::ReadWithRing(const vector<string> & paths,
+                                      vector<Result> & results,
+                                      const CandidateFilter & filter)
+    {
+#ifdef DWM_HAVE_IO_URING
+      vector<Job>     jobs(_queueDepth);
+      vector<size_t>  freeJobs;
+      for (size_t i = jobs.size(); i > 0; --i) {
+        freeJobs.push_back(i - 1);
+      }
+      size_t    next = 0;
+      uint64_t  inFlight = 0;
+      _stats.ioUring = true;
+      auto  queueRead = [&] (size_t j) {
+        Job  & job = jobs[j];
+        _ring->PrepRead(job.fd, job.buf.data(), job.buf.size(), job.offset, j);
+        ++inFlight;
+        ++_stats.reads;
+      };
+      
+      while ((next < paths.size()) || inFlight) {
+        //  Start as many files as we have free jobs for.
+        while ((next < paths.size()) && (! freeJobs.empty())) {
+          size_t  j = freeJobs.back();
+          jobs[j].idx = next;
+          if (Begin(jobs[j], paths[next])) {
+            freeJobs.pop_back();
+            ++_stats.files;
+            queueRead(j);
+          }
+          ++next;
+        }
+        if (! inFlight) {
+          continue;
+        }
+        ++_stats.waits;
+        _stats.depthSum += inFlight;
+        _stats.maxDepth = max(_stats.maxDepth, inFlight);
+        if (! _ring->Enter(1)) {
+          break;
+        }
+        uint64_t  userData;
+        int       res;
+        while (_ring->Reap(userData, res)) {
+          --inFlight;
+          Job  & job = jobs[userData];
+          if (Advance(job, res, results[job.idx], filter)) {
+            queueRead(userData);
+          }
+          else {
+            close(job.fd);
+            freeJobs.push_back(userData);
+          }
+        }
+      }
+      if (inFlight) {
+        //  io_uring_enter() failed on us.  Reads we already submitted may
+        //  still be writing into jobs' buffers, so wait for all of their
+        //  completions before closing files and letting go of jobs.  Then
+        //  give up on the ring; later batches use pread().
+        uint64_t  submitted = inFlight - _ring->Unsubmitted();
+        uint64_t  userData;
+        int       res;
+        while (submitted) {
+          if (_ring->Reap(userData, res)) {
+            --submitted;
+          }
+          else {
+            sched_yield();
+          }
+        }
+        _ring.reset();
+        //  Don't leave the files we had in flight unread; let the caller
+        //  deal with them another way.
+        for (size_t j = 0; j < jobs.size(); ++j) {
+          if (find(freeJobs.begin(), freeJobs.end(), j) == freeJobs.end()) {
+            results[jobs[j].idx].status = Status::Failed;
+            close(jobs[j].fd);
+          }
+        }
+        for ( ; next < paths.size(); ++next) {
+          results[next].status = Status::Failed;
+        }
+      }
+#endif
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ElfBatchReader::ReadWithPread(const vector<string> & paths,
+                                       vector<Result> & results,
+                                       const CandidateFilter & filter)
+    {
+      Job  job;
+      for (size_t i = 0; i < paths.size(); ++i) {
+        job.idx = i;
+        if (! Begin(job, paths[i])) {
+          continue;
+        }
+        ++_stats.files;
+        long  len;
+        do {
+          len = pread(job.fd, job.buf.data(), job.buf.size(), job.offset);
+          ++_stats.reads;
+          ++_stats.waits;
+          ++_stats.depthSum;
+          _stats.maxDepth = max(_stats.maxDepth, (uint64_t)1);
+        } while (Advance(job, len, results[i], filter));
+        close(job.fd);
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Opens the file and sets up the read of the ELF header.
+    //------------------------------------------------------------------------
+    bool ElfBatchReader::Begin(Job & job, const string & path)
+    {
+      job.fd = open(path.c_str(), O_RDONLY|O_CLOEXEC);
+      if (job.fd < 0) {
+        return false;
+      }
+      struct stat  st;
+      if (fstat(job.fd, &st) != 0) {
+        close(job.fd);
+        job.fd = -1;
+        return false;
+      }
+      job.fileSize = st.st_size;
+      job.stage = Job::k_header;
+      job.SetRead(0, 64);
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Consumes the @c len bytes just read into @c job.buf.  Returns true
+    //!  if @c job needs another read (already set up in @c job), false if
+    //!  the file is finished and @c result is filled in.
+    //------------------------------------------------------------------------
+    bool ElfBatchReader::Advance(Job & job, long len, Result & result,
+                                 const CandidateFilter & filter)
+    {
+      size_t  n = (len > 0) ? len : 0;
+      switch (job.stage) {
+        case Job::k_header:
+          if ((! ParseHeader(job.buf.data(), n, job.hdr))
+              || ((job.hdr.type != k_etExec) && (job.hdr.type != k_etDyn))
+              || (job.hdr.phnum == 0) || (job.hdr.phnum == k_pnXNum)
+              || (job.hdr.phentsize < 4) || (job.hdr.phentsize > 256)) {
+            result.status = Status::NotDynamic;
+            return false;
+          }
+          result.arch = DebianArch(job.hdr);
+          job.stage = Job::k_phdrs;
+          job.SetRead(job.hdr.phoff, job.hdr.phnum * job.hdr.phentsize);
+          return true;
+          
+        case Job::k_phdrs:
+          if ((n != job.buf.size())
+              || (! ParseProgramHeaders(job.buf.data(), job.hdr, job.phdrs))
+              || (! job.phdrs.haveDynamic)) {
+            result.status = Status::NotDynamic;
+            return false;
+          }
+          if (filter && (! filter(job.idx))) {
+            result.status = Status::Skipped;
+            return false;
+          }
+          if (job.phdrs.dynSize == 0) {
+            result.status = Status::Parsed;
+            return false;
+          }
+          if (job.phdrs.dynSize > k_maxDynamicSize) {
+            result.status = Status::Failed;
+            return false;
+          }
+          job.stage = Job::k_dynamic;
+          job.SetRead(job.phdrs.dynOffset, job.phdrs.dynSize);
+          return true;
+
+        case Job::k_dynamic:
+          {
+            if (n != job.buf.size()) {
+              result.status = Status::Failed;
+              return false;
+            }
+            ParseDynamic(job.buf.data(), n, job.hdr, job.dyn);
+            vector<uint64_t>  idxs(job.dyn.neededIdx);
+            if (job.dyn.haveSoname)   { idxs.push_back(job.dyn.sonameIdx);  }
+            if (job.dyn.haveRpath)    { idxs.push_back(job.dyn.rpathIdx);   }
+            if (job.dyn.haveRunpath)  { idxs.push_back(job.dyn.runpathIdx); }
+            if (idxs.empty()) {
+              result.status = Status::Parsed;
+              return false;
+            }
+            uint64_t  strtab;
+            auto  [minIdx, maxIdx] = minmax_element(idxs.begin(), idxs.end());
+            if ((! job.dyn.haveStrtab)
+                || (! VaddrToOffset(job.phdrs.loads, job.dyn.strtabAddr,
+                                    strtab))
+                || (strtab >= job.fileSize)) {
+              result.status = Status::Failed;
+              return false;
+            }
+            //  Only read the part of the string table that holds the
+            //  strings we want, plus enough for the last one.  The
+            //  indexes come straight from the file, so the span must
+            //  lie within the file and within k_maxStrtabSize.
+            uint64_t  strsz = min(job.dyn.strsz, job.fileSize - strtab);
+            uint64_t  end = min(strsz, *maxIdx + k_strtabSlop);
+            if ((*maxIdx >= strsz) || ((end - *minIdx) > k_maxStrtabSize)) {
+              result.status = Status::Failed;
+              return false;
+            }
+            job.strBase = *minIdx;
+            job.stage = Job::k_strtab;
+            job.SetRead(strtab + *minIdx, end - *minIdx);
+          }
+          return true;
+
+        case Job::k_strtab:
+          {
+            auto  stringAt = [&] (uint64_t idx, string & s)
+            {
+              uint64_t     rel = idx - job.strBase;
+              const void  *nul = (rel < n)
+                ? memchr(job.buf.data() + rel, '\0', n - rel) : nullptr;
+              if (nul) {
+                s.assign((const char *)job.buf.data() + rel,
+                         (const uint8_t *)nul - (job.buf.data() + rel));
+              }
+              return (nul != nullptr);
+            };
+            result.needed.resize(job.dyn.neededIdx.size());
+            for (size_t i = 0; i < job.dyn.neededIdx.size(); ++i) {
+              if (! stringAt(job.dyn.neededIdx[i], result.needed[i])) {
+                result.needed.clear();
+                result.status = Status::Failed;
+                return false;
+              }
+            }
+            if ((job.dyn.haveSoname
+                 && (! stringAt(job.dyn.sonameIdx, result.soname)))
+                || (job.dyn.haveRpath
+                    && (! stringAt(job.dyn.rpathIdx, result.rpath)))
+                || (job.dyn.haveRunpath
+                    && (! stringAt(job.dyn.runpathIdx, result.runpath)))) {
+              result.needed.clear();
+              result.status = Status::Failed;
+              return false;
+            }
+          }
+          result.status = Status::Parsed;
+          return false;
+      }
+      return false;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,184 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebElfBatchReader.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ElfBatchReader class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBELFBATCHREADER_HH_
+#define _DWMDEBELFBATCHREADER_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  Classifies and reads the DT_NEEDED entries of many files at once.
+    //!  Each file goes through the same sequence of small reads: the ELF
+    //!  header, the program header table, the dynamic section and the part
+    //!  of the dynamic string table holding the NEEDED names.
+    //!
+    //!  On Linux, the reads for up to QueueDepth() files are kept in
+    //!  flight together with io_uring(7), so a cold-cache scan keeps the
+    //!  device queue full instead of waiting on one read at a time.  If
+    //!  io_uring isn't available (old kernel, seccomp, other platforms),
+    //!  the same reads are done one at a time with pread(2).
+    //------------------------------------------------------------------------
+    class ElfBatchReader
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Per-file outcome.
+      //----------------------------------------------------------------------
+      enum class Status {
+        NotDynamic,   //!< not a dynamically linked ELF object
+        Skipped,      //!< dynamic, but the candidate filter declined it
+        Parsed,       //!< needed holds the DT_NEEDED entries
+        Failed        //!< dynamic, but we couldn't read it; try elsewhere
+      };
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      struct Result
+      {
+        Status                    status;
+        std::vector<std::string>  needed;
+        std::string               soname;
+        std::string               rpath;
+        std::string               runpath;
+        std::string               arch;
+      };
+
+      //----------------------------------------------------------------------
+      //!  Called with the index of a file once it is known to be a
+      //!  dynamically linked ELF object.  Returning false stops reading
+      //!  that file (its status will be Skipped); callers use this to skip
+      //!  files they already have results for.
+      //----------------------------------------------------------------------
+      using CandidateFilter = std::function<bool(size_t)>;
+
+      //----------------------------------------------------------------------
+      //!  I/O statistics, accumulated over all calls to Read().
+      //----------------------------------------------------------------------
+      struct Stats
+      {
+        uint64_t  files;
+        uint64_t  reads;
+        uint64_t  waits;
+        uint64_t  depthSum;
+        uint64_t  maxDepth;
+        bool      ioUring;   //!< true if any reads were done with io_uring
+
+        Stats()
+            : files(0), reads(0), waits(0), depthSum(0), maxDepth(0),
+              ioUring(false)
+        {}
+        
+        Stats & operator += (const Stats & stats);
+
+        //--------------------------------------------------------------------
+        //!  Mean number of reads in flight each time we waited for
+        //!  completions.
+        //--------------------------------------------------------------------
+        double MeanDepth() const
+        { return (waits ? ((double)depthSum / waits) : 0.0); }
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Uses io_uring with @c queueDepth entries if @c useIoUring is
+      //!  true and the kernel allows it, else pread(2).
+      //----------------------------------------------------------------------
+      ElfBatchReader(bool useIoUring, unsigned int queueDepth = 256);
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ~ElfBatchReader();
+
+      ElfBatchReader(const ElfBatchReader &) = delete;
+      ElfBatchReader & operator = (const ElfBatchReader &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if we got an io_uring instance.
+      //----------------------------------------------------------------------
+      bool UsingIoUring() const;
+      
+      //----------------------------------------------------------------------
+      //!  Reads all of the files in @c paths.  On return, @c results has
+      //!  one entry per path, in the same order.
+      //----------------------------------------------------------------------
+      void Read(const std::vector<std::string> & paths,
+                std::vector<Result> & results,
+                CandidateFilter filter = nullptr);
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      const Stats & GetStats() const
+      { return _stats; }
+      
+    private:
+      class Ring;
+      struct Job;
+      
+      std::unique_ptr<Ring>  _ring;
+      unsigned int           _queueDepth;
+      Stats                  _stats;
+
+      void ReadWithRing(const std::vector<std::string> & paths,
+                        std::vector<Result> & results,
+                        const CandidateFilter & filter);
+      void ReadWithPread(const std::vector<std::string> & paths,
+                         std::vector<Result> & results,
+                         const CandidateFilter & filter);
+      static bool Begin(Job & job, const std::string & path);
+      static bool Advance(Job & job, long len, Result & result,
+                          const CandidateFilter & filter);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBELFBATCHREADER_HH_
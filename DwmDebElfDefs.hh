@@ -0,0 +1,435 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebElfDefs.hh
+//!  \author Daniel W. McRobb
+//!  \brief ELF constants and field accessors shared by the ELF readers
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBELFDEFS_HH_
+#define _DWMDEBELFDEFS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  We carry our own constants instead of using <elf.h>, which isn't
+    //!  available everywhere (macOS).  Values and offsets are from the
+    //!  System V ABI.
+    //------------------------------------------------------------------------
+    namespace Elf {
+
+      constexpr uint8_t   k_class32   = 1;
+      constexpr uint8_t   k_class64   = 2;
+      constexpr uint8_t   k_dataLsb   = 1;
+      constexpr uint8_t   k_dataMsb   = 2;
+      constexpr uint16_t  k_etExec    = 2;
+      constexpr uint16_t  k_etDyn     = 3;
+      constexpr uint16_t  k_pnXNum    = 0xffff;
+      constexpr uint32_t  k_ptLoad    = 1;
+      constexpr uint32_t  k_ptDynamic = 2;
+      constexpr uint64_t  k_dtNull    = 0;
+      constexpr uint64_t  k_dtNeeded  = 1;
+      constexpr uint64_t  k_dtStrTab  = 5;
+      constexpr uint64_t  k_dtStrSz   = 10;
+      constexpr uint64_t  k_dtHash    = 4;
+      constexpr uint64_t  k_dtSymTab  = 6;
+      constexpr uint64_t  k_dtSymEnt  = 11;
+      constexpr uint64_t  k_dtSoname  = 14;
+      constexpr uint64_t  k_dtRpath   = 15;
+      constexpr uint64_t  k_dtRunpath = 29;
+      constexpr uint64_t  k_dtGnuHash = 0x6ffffef5;
+      constexpr uint64_t  k_dtVerSym  = 0x6ffffff0;
+      constexpr uint64_t  k_dtVerNeed = 0x6ffffffe;
+      constexpr uint64_t  k_dtVerNeedNum = 0x6fffffff;
+      constexpr uint16_t  k_shnUndef  = 0;
+      constexpr uint8_t   k_stbGlobal = 1;
+      constexpr uint8_t   k_stbWeak   = 2;
+      constexpr uint16_t  k_versymHidden = 0x8000;
+      constexpr uint16_t  k_emSparc   = 2;
+      constexpr uint16_t  k_em386     = 3;
+      constexpr uint16_t  k_em68k     = 4;
+      constexpr uint16_t  k_emMips    = 8;
+      constexpr uint16_t  k_emParisc  = 15;
+      constexpr uint16_t  k_emPpc     = 20;
+      constexpr uint16_t  k_emPpc64   = 21;
+      constexpr uint16_t  k_emS390    = 22;
+      constexpr uint16_t  k_emArm     = 40;
+      constexpr uint16_t  k_emSh      = 42;
+      constexpr uint16_t  k_emSparcV9 = 43;
+      constexpr uint16_t  k_emIa64    = 50;
+      constexpr uint16_t  k_emX86_64  = 62;
+      constexpr uint16_t  k_emAarch64 = 183;
+      constexpr uint16_t  k_emRiscv   = 243;
+      constexpr uint16_t  k_emLoongArch = 258;
+      constexpr uint16_t  k_emAlpha   = 0x9026;
+      constexpr uint32_t  k_efArmAbiFloatHard = 0x400;
+
+      //----------------------------------------------------------------------
+      //!  Reads an unsigned integer of @c len bytes (1, 2, 4 or 8) from
+      //!  @c p in the given byte order.
+      //----------------------------------------------------------------------
+      inline uint64_t ReadInt(const uint8_t *p, size_t len, bool bigEndian)
+      {
+        uint64_t  rc = 0;
+        if (bigEndian) {
+          for (size_t i = 0; i < len; ++i) {
+            rc = (rc << 8) | p[i];
+          }
+        }
+        else {
+          for (size_t i = len; i > 0; --i) {
+            rc = (rc << 8) | p[i - 1];
+          }
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Fields of the ELF header we care about, wherever they live for
+      //!  the object's class.
+      //----------------------------------------------------------------------
+      struct Header
+      {
+        bool      is64;
+        bool      bigEndian;
+        uint16_t  type;
+        uint16_t  machine;
+        uint32_t  flags;
+        uint64_t  phoff;
+        uint64_t  phentsize;
+        uint64_t  phnum;
+      };
+
+      //----------------------------------------------------------------------
+      //!  Decodes the ELF header in the first @c len bytes at @c p.
+      //!  Returns false if it's not an ELF header we understand.
+      //----------------------------------------------------------------------
+      inline bool ParseHeader(const uint8_t *p, size_t len, Header & hdr)
+      {
+        if ((len < 52) || (p[0] != 0x7f) || (p[1] != 'E') || (p[2] != 'L')
+            || (p[3] != 'F')
+            || ((p[4] != k_class32) && (p[4] != k_class64))
+            || ((p[5] != k_dataLsb) && (p[5] != k_dataMsb))) {
+          return false;
+        }
+        hdr.is64 = (p[4] == k_class64);
+        hdr.bigEndian = (p[5] == k_dataMsb);
+        if (hdr.is64 && (len < 64)) {
+          return false;
+        }
+        bool  be = hdr.bigEndian;
+        hdr.type = ReadInt(p + 16, 2, be);
+        hdr.machine = ReadInt(p + 18, 2, be);
+        hdr.flags = ReadInt(p + (hdr.is64 ? 48 : 36), 4, be);
+        hdr.phoff = hdr.is64 ? ReadInt(p + 32, 8, be) : ReadInt(p + 28, 4, be);
+        hdr.phentsize = ReadInt(p + (hdr.is64 ? 54 : 42), 2, be);
+        hdr.phnum = ReadInt(p + (hdr.is64 ? 56 : 44), 2, be);
+        return true;
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Returns the Debian architecture (as in 'dpkg --print-architecture')
+      //!  of objects with header @c hdr, from e_machine, the class, the
+      //!  byte order and, for ARM, the float ABI in e_flags.  Returns an
+      //!  empty string if we don't know the combination.
+      //----------------------------------------------------------------------
+      inline const char *DebianArch(const Header & hdr)
+      {
+        bool  le = (! hdr.bigEndian);
+        bool  is64 = hdr.is64;
+        switch (hdr.machine) {
+          case k_emSparc:      return is64 ? "" : "sparc";
+          case k_em386:        return is64 ? "" : "i386";
+          case k_em68k:        return is64 ? "" : "m68k";
+          case k_emMips:
+            if (is64) {
+              return le ? "mips64el" : "mips64";
+            }
+            return le ? "mipsel" : "mips";
+          case k_emParisc:     return is64 ? "" : "hppa";
+          case k_emPpc:        return (is64 || le) ? "" : "powerpc";
+          case k_emPpc64:      return is64 ? (le ? "ppc64el" : "ppc64") : "";
+          case k_emS390:       return is64 ? "s390x" : "s390";
+          case k_emArm:
+            if (is64 || (! le)) {
+              return "";
+            }
+            return (hdr.flags & k_efArmAbiFloatHard) ? "armhf" : "armel";
+          case k_emSh:         return (is64 || (! le)) ? "" : "sh4";
+          case k_emSparcV9:    return is64 ? "sparc64" : "";
+          case k_emIa64:       return is64 ? "ia64" : "";
+          case k_emX86_64:     return is64 ? "amd64" : "x32";
+          case k_emAarch64:    return (is64 && le) ? "arm64" : "";
+          case k_emRiscv:      return (is64 && le) ? "riscv64" : "";
+          case k_emLoongArch:  return (is64 && le) ? "loong64" : "";
+          case k_emAlpha:      return is64 ? "alpha" : "";
+          default:             break;
+        }
+        return "";
+      }
+      
+      //----------------------------------------------------------------------
+      //!  A PT_LOAD segment, used to map virtual addresses (as found in
+      //!  the dynamic section) to file offsets.
+      //----------------------------------------------------------------------
+      struct LoadSegment
+      {
+        uint64_t  vaddr;
+        uint64_t  offset;
+        uint64_t  filesz;
+      };
+
+      //----------------------------------------------------------------------
+      //!  What we learn from the program header table.
+      //----------------------------------------------------------------------
+      struct ProgramHeaders
+      {
+        std::vector<LoadSegment>  loads;
+        bool                      haveDynamic;
+        uint64_t                  dynOffset;
+        uint64_t                  dynSize;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Decodes @c hdr.phnum program headers from @c p, which must hold
+      //!  at least @c hdr.phnum * @c hdr.phentsize bytes.  Returns false
+      //!  if the entries are too small to be program headers.
+      //----------------------------------------------------------------------
+      inline bool ParseProgramHeaders(const uint8_t *p, const Header & hdr,
+                                      ProgramHeaders & phdrs)
+      {
+        phdrs.loads.clear();
+        phdrs.haveDynamic = false;
+        phdrs.dynOffset = 0;
+        phdrs.dynSize = 0;
+        if (hdr.phnum && (hdr.phentsize < (hdr.is64 ? 56 : 32))) {
+          return false;
+        }
+        bool  be = hdr.bigEndian;
+        for (uint64_t i = 0; i < hdr.phnum; ++i) {
+          const uint8_t  *ph = p + (i * hdr.phentsize);
+          uint32_t        ptype = ReadInt(ph, 4, be);
+          uint64_t        offset, filesz;
+          if (hdr.is64) {
+            offset = ReadInt(ph + 8, 8, be);
+            filesz = ReadInt(ph + 32, 8, be);
+          }
+          else {
+            offset = ReadInt(ph + 4, 4, be);
+            filesz = ReadInt(ph + 16, 4, be);
+          }
+          if (ptype == k_ptLoad) {
+            uint64_t  vaddr = hdr.is64 ? ReadInt(ph + 16, 8, be)
+                                       : ReadInt(ph + 8, 4, be);
+            phdrs.loads.push_back({vaddr, offset, filesz});
+          }
+          else if (ptype == k_ptDynamic) {
+            phdrs.haveDynamic = true;
+            phdrs.dynOffset = offset;
+            phdrs.dynSize = filesz;
+          }
+        }
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Maps the virtual address @c vaddr to a file offset using the
+      //!  PT_LOAD segments in @c loads.
+      //----------------------------------------------------------------------
+      inline bool VaddrToOffset(const std::vector<LoadSegment> & loads,
+                                uint64_t vaddr, uint64_t & offset)
+      {
+        for (const auto & load : loads) {
+          if ((vaddr >= load.vaddr) && ((vaddr - load.vaddr) < load.filesz)) {
+            offset = load.offset + (vaddr - load.vaddr);
+            return true;
+          }
+        }
+        return false;
+      }
+      
+      //----------------------------------------------------------------------
+      //!  What we learn from the dynamic section.  String values are
+      //!  indices into the dynamic string table; addresses are virtual
+      //!  addresses and zero if the tag is absent.
+      //----------------------------------------------------------------------
+      struct Dynamic
+      {
+        std::vector<uint64_t>  neededIdx;
+        bool                   haveStrtab;
+        uint64_t               strtabAddr;
+        uint64_t               strsz;
+        bool                   haveSoname;
+        uint64_t               sonameIdx;
+        bool                   haveRpath;
+        uint64_t               rpathIdx;
+        bool                   haveRunpath;
+        uint64_t               runpathIdx;
+        uint64_t               symtabAddr;
+        uint64_t               syment;
+        uint64_t               hashAddr;
+        uint64_t               gnuHashAddr;
+        uint64_t               versymAddr;
+        uint64_t               verneedAddr;
+        uint64_t               verneedNum;
+      };
+
+      //----------------------------------------------------------------------
+      //!  Decodes the dynamic section held in the @c len bytes at @c p,
+      //!  stopping at DT_NULL.
+      //----------------------------------------------------------------------
+      inline void ParseDynamic(const uint8_t *p, size_t len,
+                               const Header & hdr, Dynamic & dyn)
+      {
+        dyn.neededIdx.clear();
+        dyn.haveStrtab = false;
+        dyn.strtabAddr = 0;
+        dyn.strsz = 0;
+        dyn.haveSoname = false;
+        dyn.sonameIdx = 0;
+        dyn.haveRpath = false;
+        dyn.rpathIdx = 0;
+        dyn.haveRunpath = false;
+        dyn.runpathIdx = 0;
+        dyn.symtabAddr = 0;
+        dyn.syment = 0;
+        dyn.hashAddr = 0;
+        dyn.gnuHashAddr = 0;
+        dyn.versymAddr = 0;
+        dyn.verneedAddr = 0;
+        dyn.verneedNum = 0;
+        size_t  fieldSize = hdr.is64 ? 8 : 4;
+        for (size_t d = 0; (d + (2 * fieldSize)) <= len; d += 2 * fieldSize) {
+          uint64_t  tag = ReadInt(p + d, fieldSize, hdr.bigEndian);
+          uint64_t  val = ReadInt(p + d + fieldSize, fieldSize, hdr.bigEndian);
+          if (tag == k_dtNull) {
+            break;
+          }
+          switch (tag) {
+            case k_dtNeeded:
+              dyn.neededIdx.push_back(val);
+              break;
+            case k_dtStrTab:
+              dyn.strtabAddr = val;
+              dyn.haveStrtab = true;
+              break;
+            case k_dtStrSz:
+              dyn.strsz = val;
+              break;
+            case k_dtSoname:
+              dyn.sonameIdx = val;
+              dyn.haveSoname = true;
+              break;
+            case k_dtRpath:
+              dyn.rpathIdx = val;
+              dyn.haveRpath = true;
+              break;
+            case k_dtRunpath:
+              dyn.runpathIdx = val;
+              dyn.haveRunpath = true;
+              break;
+            case k_dtSymTab:
+              dyn.symtabAddr = val;
+              break;
+            case k_dtSymEnt:
+              dyn.syment = val;
+              break;
+            case k_dtHash:
+              dyn.hashAddr = val;
+              break;
+            case k_dtGnuHash:
+              dyn.gnuHashAddr = val;
+              break;
+            case k_dtVerSym:
+              dyn.versymAddr = val;
+              break;
+            case k_dtVerNeed:
+              dyn.verneedAddr = val;
+              break;
+            case k_dtVerNeedNum:
+              dyn.verneedNum = val;
+              break;
+            default:
+              break;
+          }
+        }
+        return;
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Fields of a dynamic symbol table entry we care about.
+      //----------------------------------------------------------------------
+      struct Symbol
+      {
+        uint32_t  name;
+        uint8_t   bind;
+        uint16_t  shndx;
+      };
+
+      //----------------------------------------------------------------------
+      //!  Returns the size of a symbol table entry for the object's class.
+      //----------------------------------------------------------------------
+      inline size_t SymbolSize(const Header & hdr)
+      {
+        return (hdr.is64 ? 24 : 16);
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Decodes the symbol table entry at @c p, which must hold at least
+      //!  SymbolSize(hdr) bytes.
+      //----------------------------------------------------------------------
+      inline void ParseSymbol(const uint8_t *p, const Header & hdr,
+                              Symbol & sym)
+      {
+        sym.name = ReadInt(p, 4, hdr.bigEndian);
+        sym.bind = p[hdr.is64 ? 4 : 12] >> 4;
+        sym.shndx = ReadInt(p + (hdr.is64 ? 6 : 14), 2, hdr.bigEndian);
+        return;
+      }
+      
+    }  // namespace Elf
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBELFDEFS_HH_
@@ -0,0 +1,409 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebElfFile.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ElfFile class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cstring>
+
+#include "DwmDebElfDefs.hh"
+#include "DwmDebElfFile.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    using namespace Elf;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ElfFile::ElfFile()
+        : _data(nullptr), _size(0), _isElf(false), _needed(), _soname(),
+          _rpath(), _runpath(), _undefined(),
+          _hdr(), _phdrs(), _dyn(), _strtab(0), _strsz(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ElfFile::~ElfFile()
+    {
+      Close();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::Open(const string & path)
+    {
+      Close();
+      
+      bool  rc = false;
+      int   fd = open(path.c_str(), O_RDONLY);
+      if (fd >= 0) {
+        struct stat  st;
+        if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode)
+            && (st.st_size >= 16)) {
+          void  *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE,
+                             fd, 0);
+          if (addr != MAP_FAILED) {
+            _data = (const uint8_t *)addr;
+            _size = st.st_size;
+            rc = Parse();
+          }
+        }
+        close(fd);
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::IsDynamicObject(const string & path)
+    {
+      bool  rc = false;
+      int   fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        return rc;
+      }
+      uint8_t      ehdr[64];
+      ssize_t      len = pread(fd, ehdr, sizeof(ehdr), 0);
+      Elf::Header  hdr;
+      if ((len > 0) && ParseHeader(ehdr, len, hdr)
+          && ((hdr.type == k_etExec) || (hdr.type == k_etDyn))
+          && (hdr.phnum > 0) && (hdr.phnum != k_pnXNum)
+          && (hdr.phentsize >= 4) && (hdr.phentsize <= 256)) {
+        vector<uint8_t>  phdrs(hdr.phnum * hdr.phentsize);
+        len = pread(fd, phdrs.data(), phdrs.size(), hdr.phoff);
+        if ((len > 0) && ((size_t)len == phdrs.size())) {
+          for (uint64_t i = 0; i < hdr.phnum; ++i) {
+            if (ReadInt(&phdrs[i * hdr.phentsize], 4, hdr.bigEndian)
+                == k_ptDynamic) {
+              rc = true;
+              break;
+            }
+          }
+        }
+      }
+      close(fd);
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ElfFile::Close()
+    {
+      if (_data) {
+        munmap((void *)_data, _size);
+        _data = nullptr;
+      }
+      _size = 0;
+      _isElf = false;
+      _needed.clear();
+      _soname = string_view();
+      _rpath = string_view();
+      _runpath = string_view();
+      _undefined.clear();
+      _hdr = Elf::Header();
+      _phdrs = Elf::ProgramHeaders();
+      _dyn = Elf::Dynamic();
+      _strtab = 0;
+      _strsz = 0;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::StringAt(uint64_t strtab, uint64_t strsz, uint64_t idx,
+                           string_view & s) const
+    {
+      bool  rc = false;
+      if (idx < strsz) {
+        const char  *p = (const char *)_data + strtab + idx;
+        const void  *nul = memchr(p, '\0', strsz - idx);
+        if (nul) {
+          s = string_view(p, (const char *)nul - p);
+          rc = true;
+        }
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::Parse()
+    {
+      if (memcmp(_data, "\177ELF", 4) != 0) {
+        return false;
+      }
+      _isElf = true;
+
+      if ((! ParseHeader(_data, _size, _hdr)) || (_hdr.phnum == k_pnXNum)
+          || (_hdr.phoff > _size)
+          || ((_hdr.phnum * _hdr.phentsize) > (_size - _hdr.phoff))) {
+        return false;
+      }
+      if (! ParseProgramHeaders(_data + _hdr.phoff, _hdr, _phdrs)) {
+        return false;
+      }
+      if (! _phdrs.haveDynamic) {
+        //  Statically linked; nothing is needed.
+        return true;
+      }
+      if ((_phdrs.dynOffset > _size)
+          || (_phdrs.dynSize > (_size - _phdrs.dynOffset))) {
+        return false;
+      }
+      
+      ParseDynamic(_data + _phdrs.dynOffset, _phdrs.dynSize, _hdr, _dyn);
+      if (_dyn.haveStrtab
+          && VaddrToOffset(_phdrs.loads, _dyn.strtabAddr, _strtab)
+          && (_strtab <= _size)) {
+        _strsz = _dyn.strsz;
+        if (_strsz > (_size - _strtab)) {
+          _strsz = _size - _strtab;
+        }
+      }
+      else if ((! _dyn.neededIdx.empty()) || _dyn.haveSoname
+               || _dyn.haveRpath || _dyn.haveRunpath) {
+        return false;
+      }
+      _needed.reserve(_dyn.neededIdx.size());
+      for (auto idx : _dyn.neededIdx) {
+        string_view  s;
+        if (! StringAt(_strtab, _strsz, idx, s)) {
+          _needed.clear();
+          return false;
+        }
+        _needed.push_back(s);
+      }
+      if ((_dyn.haveSoname && (! StringAt(_strtab, _strsz, _dyn.sonameIdx,
+                                          _soname)))
+          || (_dyn.haveRpath && (! StringAt(_strtab, _strsz, _dyn.rpathIdx,
+                                            _rpath)))
+          || (_dyn.haveRunpath && (! StringAt(_strtab, _strsz,
+                                              _dyn.runpathIdx, _runpath)))) {
+        _needed.clear();
+        return false;
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::AddrToOffset(uint64_t addr, uint64_t len,
+                               uint64_t & offset) const
+    {
+      return (VaddrToOffset(_phdrs.loads, addr, offset)
+              && (offset <= _size) && (len <= (_size - offset)));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  The dynamic section doesn't record the number of dynamic symbols,
+    //!  so we get it from the hash table.  With DT_HASH it's simply the
+    //!  number of chain entries.  With DT_GNU_HASH it's one past the last
+    //!  symbol in the chain of the highest-numbered bucket.
+    //------------------------------------------------------------------------
+    bool ElfFile::NumSymbols(uint64_t & count) const
+    {
+      bool      be = _hdr.bigEndian;
+      uint64_t  off;
+      if (_dyn.hashAddr) {
+        if (AddrToOffset(_dyn.hashAddr, 8, off)) {
+          count = ReadInt(_data + off + 4, 4, be);
+          return true;
+        }
+        return false;
+      }
+      if ((! _dyn.gnuHashAddr) || (! AddrToOffset(_dyn.gnuHashAddr, 16, off))) {
+        return false;
+      }
+      uint64_t  nbuckets = ReadInt(_data + off, 4, be);
+      uint64_t  symoffset = ReadInt(_data + off + 4, 4, be);
+      uint64_t  bloomSize = ReadInt(_data + off + 8, 4, be);
+      uint64_t  buckets = off + 16 + (bloomSize * (_hdr.is64 ? 8 : 4));
+      if ((buckets > _size) || (nbuckets > ((_size - buckets) / 4))) {
+        return false;
+      }
+      uint64_t  maxBucket = 0;
+      for (uint64_t i = 0; i < nbuckets; ++i) {
+        uint64_t  b = ReadInt(_data + buckets + (i * 4), 4, be);
+        if (b > maxBucket) {
+          maxBucket = b;
+        }
+      }
+      if (maxBucket < symoffset) {
+        count = symoffset;
+        return true;
+      }
+      uint64_t  chain = buckets + (nbuckets * 4)
+        + ((maxBucket - symoffset) * 4);
+      for ( ; (chain + 4) <= _size; chain += 4, ++maxBucket) {
+        if (ReadInt(_data + chain, 4, be) & 1) {
+          count = maxBucket + 1;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Walks the DT_VERNEED entries, filling @c versions so that it can be
+    //!  indexed by the version index found in DT_VERSYM.
+    //------------------------------------------------------------------------
+    bool ElfFile::ReadVersionNeeds(vector<SymbolRef> & versions) const
+    {
+      versions.clear();
+      bool      be = _hdr.bigEndian;
+      uint64_t  off;
+      if (! _dyn.verneedAddr) {
+        return true;
+      }
+      if (! AddrToOffset(_dyn.verneedAddr, 16, off)) {
+        return false;
+      }
+      for (uint64_t n = 0; n < _dyn.verneedNum; ++n) {
+        if ((off > _size) || (16 > (_size - off))) {
+          return false;
+        }
+        const uint8_t  *vn = _data + off;
+        uint64_t        cnt = ReadInt(vn + 2, 2, be);
+        uint64_t        auxOff = off + ReadInt(vn + 8, 4, be);
+        uint64_t        next = ReadInt(vn + 12, 4, be);
+        string_view     file;
+        if (! StringAt(_strtab, _strsz, ReadInt(vn + 4, 4, be), file)) {
+          return false;
+        }
+        for (uint64_t a = 0; a < cnt; ++a) {
+          if ((auxOff > _size) || (16 > (_size - auxOff))) {
+            return false;
+          }
+          const uint8_t  *vna = _data + auxOff;
+          uint16_t        idx = ReadInt(vna + 6, 2, be) & ~k_versymHidden;
+          uint64_t        anext = ReadInt(vna + 12, 4, be);
+          string_view     name;
+          if (! StringAt(_strtab, _strsz, ReadInt(vna + 8, 4, be), name)) {
+            return false;
+          }
+          if (idx >= versions.size()) {
+            versions.resize(idx + 1);
+          }
+          versions[idx] = { string_view(), name, file };
+          if (! anext) {
+            break;
+          }
+          auxOff += anext;
+        }
+        if (! next) {
+          break;
+        }
+        off += next;
+      }
+      return true;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ElfFile::ReadUndefinedSymbols()
+    {
+      _undefined.clear();
+      if ((! _data) || (! _phdrs.haveDynamic) || (! _dyn.symtabAddr)
+          || (! _strsz)) {
+        return false;
+      }
+      uint64_t  count;
+      uint64_t  entSize = _dyn.syment ? _dyn.syment : SymbolSize(_hdr);
+      uint64_t  symtab;
+      if ((! NumSymbols(count)) || (entSize < SymbolSize(_hdr))
+          || (count > (_size / entSize))
+          || (! AddrToOffset(_dyn.symtabAddr, count * entSize, symtab))) {
+        return false;
+      }
+      uint64_t  versym = 0;
+      bool      haveVersym = (_dyn.versymAddr
+                              && AddrToOffset(_dyn.versymAddr, count * 2,
+                                              versym));
+      vector<SymbolRef>  versions;
+      if (! ReadVersionNeeds(versions)) {
+        return false;
+      }
+      //  Entry 0 is always the null symbol.
+      for (uint64_t i = 1; i < count; ++i) {
+        Elf::Symbol  sym;
+        ParseSymbol(_data + symtab + (i * entSize), _hdr, sym);
+        if ((sym.shndx != k_shnUndef) || (! sym.name)
+            || ((sym.bind != k_stbGlobal) && (sym.bind != k_stbWeak))) {
+          continue;
+        }
+        SymbolRef  ref;
+        if (! StringAt(_strtab, _strsz, sym.name, ref.name)) {
+          _undefined.clear();
+          return false;
+        }
+        if (haveVersym) {
+          uint16_t  idx = ReadInt(_data + versym + (i * 2), 2,
+                                  _hdr.bigEndian) & ~k_versymHidden;
+          if (idx < versions.size()) {
+            ref.version = versions[idx].version;
+            ref.library = versions[idx].library;
+          }
+        }
+        _undefined.push_back(ref);
+      }
+      return true;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,198 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebElfFile.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ElfFile class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBELFFILE_HH_
+#define _DWMDEBELFFILE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DwmDebElfDefs.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  A minimal read-only ELF reader.  Handles ELF32 and ELF64 objects of
+    //!  either byte order.  The file is mapped with mmap() and only the
+    //!  pages holding the ELF header, the program headers, the dynamic
+    //!  section and the dynamic string table are ever touched, plus the
+    //!  dynamic symbol and version tables if ReadUndefinedSymbols() is
+    //!  called.  Strings returned from accessors point directly into the
+    //!  mapping, so they are only valid until Close() is called or the
+    //!  ElfFile is destroyed.
+    //------------------------------------------------------------------------
+    class ElfFile
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  An undefined dynamic symbol, i.e. one we expect a shared library
+      //!  to provide.  For a versioned reference, @c version is the
+      //!  version name and @c library is the library it's required from
+      //!  (from DT_VERNEED).  Both are empty for an unversioned reference.
+      //----------------------------------------------------------------------
+      struct SymbolRef
+      {
+        std::string_view  name;
+        std::string_view  version;
+        std::string_view  library;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ElfFile();
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ~ElfFile();
+
+      ElfFile(const ElfFile &) = delete;
+      ElfFile & operator = (const ElfFile &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Maps the file at @c path and parses its dynamic section.  Returns
+      //!  true on success.  Returns false if the file could not be mapped,
+      //!  is not an ELF file or is an ELF file we can't make sense of; use
+      //!  IsElf() to distinguish the last case from the others.
+      //----------------------------------------------------------------------
+      bool Open(const std::string & path);
+
+      //----------------------------------------------------------------------
+      //!  Unmaps the file.  Invalidates all string_views obtained from
+      //!  this object.
+      //----------------------------------------------------------------------
+      void Close();
+
+      //----------------------------------------------------------------------
+      //!  Cheap candidate check for scanning: returns true if the file at
+      //!  @c path is an ELF executable or shared object with a PT_DYNAMIC
+      //!  program header.  Reads only the 64-byte ELF header and the
+      //!  program header table, without mapping the file.
+      //----------------------------------------------------------------------
+      static bool IsDynamicObject(const std::string & path);
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if the file carried the ELF magic number, even if
+      //!  we subsequently failed to parse it.
+      //----------------------------------------------------------------------
+      bool IsElf() const                  { return _isElf; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the DT_NEEDED entries, in the order they appear in the
+      //!  dynamic section.
+      //----------------------------------------------------------------------
+      const std::vector<std::string_view> & Needed() const
+      { return _needed; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the DT_SONAME entry, or an empty string if there is none.
+      //----------------------------------------------------------------------
+      std::string_view Soname() const     { return _soname; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the DT_RPATH entry, or an empty string if there is none.
+      //----------------------------------------------------------------------
+      std::string_view Rpath() const      { return _rpath; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the DT_RUNPATH entry, or an empty string if there is
+      //!  none.
+      //----------------------------------------------------------------------
+      std::string_view Runpath() const    { return _runpath; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the Debian architecture of the file (e.g. 'amd64'), or
+      //!  an empty string if we don't know it.  See Elf::DebianArch().
+      //----------------------------------------------------------------------
+      const char *Architecture() const
+      { return Elf::DebianArch(_hdr); }
+
+      //----------------------------------------------------------------------
+      //!  Reads the undefined global and weak symbols from the dynamic
+      //!  symbol table, along with their versions from DT_VERSYM and
+      //!  DT_VERNEED (.gnu.version and .gnu.version_r).  Must be called
+      //!  after a successful Open().  Returns false if the tables are
+      //!  missing or malformed.
+      //----------------------------------------------------------------------
+      bool ReadUndefinedSymbols();
+
+      //----------------------------------------------------------------------
+      //!  Returns the symbols found by ReadUndefinedSymbols(), in symbol
+      //!  table order.
+      //----------------------------------------------------------------------
+      const std::vector<SymbolRef> & UndefinedSymbols() const
+      { return _undefined; }
+      
+    private:
+      const uint8_t                  *_data;
+      size_t                          _size;
+      bool                            _isElf;
+      std::vector<std::string_view>   _needed;
+      std::string_view                _soname;
+      std::string_view                _rpath;
+      std::string_view                _runpath;
+      std::vector<SymbolRef>          _undefined;
+      Elf::Header                     _hdr;
+      Elf::ProgramHeaders             _phdrs;
+      Elf::Dynamic                    _dyn;
+      uint64_t                        _strtab;
+      uint64_t                        _strsz;
+
+      bool Parse();
+      bool NumSymbols(uint64_t & count) const;
+      bool ReadVersionNeeds(std::vector<SymbolRef> & versions) const;
+      bool AddrToOffset(uint64_t addr, uint64_t len,
+                        uint64_t & offset) const;
+      bool StringAt(uint64_t strtab, uint64_t strsz, uint64_t idx,
+                    std::string_view & s) const;
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBELFFILE_HH_
@@ -0,0 +1,266 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebFixedVersion.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::FixedVersion class definition
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBFIXEDVERSION_HH_
+#define _DWMDEBFIXEDVERSION_HH_
+
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+#include "DwmDebPkgVersion.hh"
+#include "DwmDebVersionCompare.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  A Debian package version held in a fixed-size buffer, so it can be
+    //!  parsed and compared at compile time.  This is for versions we
+    //!  hard-code (minimum library versions, tables of known versions and
+    //!  the like):
+    //!
+    //!  @code
+    //!  constexpr FixedVersion  k_minLibc("2.34");
+    //!  static_assert(k_minLibc > FixedVersion("2.34~rc1"));
+    //!  @endcode
+    //!
+    //!  It parses and orders exactly like PkgVersion, and compares with
+    //!  and converts to PkgVersion.
+    //------------------------------------------------------------------------
+    class FixedVersion
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Maximum length of the upstream version plus the release.
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_capacity = 64;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr FixedVersion()
+          : _epoch(0), _upstreamLen(0), _releaseLen(0), _buf()
+      {}
+
+      //----------------------------------------------------------------------
+      //!  Construct from a string literal.  A literal that's too long is
+      //!  a compile-time error.
+      //----------------------------------------------------------------------
+      template <size_t N>
+      constexpr FixedVersion(const char (&s)[N])
+          : FixedVersion()
+      {
+        static_assert(N <= (k_capacity + 1), "version literal too long");
+        FromString(std::string_view(s, N - 1));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Parses @c s the way PkgVersion::FromString() does.  Returns
+      //!  false (leaving an empty version) if @c s is empty or its
+      //!  version and release don't fit in k_capacity characters.
+      //----------------------------------------------------------------------
+      constexpr bool FromString(std::string_view s)
+      {
+        _epoch = 0;
+        _upstreamLen = _releaseLen = 0;
+        int               epoch = 0;
+        std::string_view  upstream, release;
+        if ((! VersionCompare::Split(s, epoch, upstream, release))
+            || ((upstream.size() + release.size()) > k_capacity)) {
+          return false;
+        }
+        size_t  n = 0;
+        for (char c : upstream) {
+          _buf[n++] = c;
+        }
+        for (char c : release) {
+          _buf[n++] = c;
+        }
+        _epoch = epoch;
+        _upstreamLen = upstream.size();
+        _releaseLen = release.size();
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr int Epoch() const
+      { return _epoch; }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr std::string_view Version() const
+      { return std::string_view(_buf, _upstreamLen); }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr std::string_view Release() const
+      { return std::string_view(_buf + _upstreamLen, _releaseLen); }
+
+      //----------------------------------------------------------------------
+      //!  Returns less than, equal to or greater than 0 as the version is
+      //!  less than, equal to or greater than @c fv in dpkg's ordering.
+      //----------------------------------------------------------------------
+      constexpr int Compare(const FixedVersion & fv) const
+      {
+        return VersionCompare::Compare(_epoch, Version(), Release(),
+                                       fv._epoch, fv.Version(),
+                                       fv.Release());
+      }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      int Compare(const PkgVersion & pv) const
+      {
+        return VersionCompare::Compare(_epoch, Version(), Release(),
+                                       pv.Epoch(), pv.Version().String(),
+                                       pv.Release());
+      }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      operator PkgVersion () const
+      {
+        return PkgVersion(_epoch, std::string(Version()),
+                          std::string(Release()));
+      }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr bool operator < (const FixedVersion & fv) const
+      { return (Compare(fv) < 0); }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr bool operator > (const FixedVersion & fv) const
+      { return (Compare(fv) > 0); }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr bool operator == (const FixedVersion & fv) const
+      { return (Compare(fv) == 0); }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      constexpr bool operator != (const FixedVersion & fv) const
+      { return (Compare(fv) != 0); }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      friend std::ostream & operator << (std::ostream & os,
+                                         const FixedVersion & fv)
+      {
+        if (fv._epoch) {
+          os << fv._epoch << ':';
+        }
+        os << fv.Version();
+        if (fv._releaseLen) {
+          os << '-' << fv.Release();
+        }
+        return os;
+      }
+
+    private:
+      int     _epoch;
+      size_t  _upstreamLen;
+      size_t  _releaseLen;
+      char    _buf[k_capacity];
+    };
+
+    //------------------------------------------------------------------------
+    //!  Comparisons between a PkgVersion and a FixedVersion, in either
+    //!  order.
+    //------------------------------------------------------------------------
+    inline bool operator < (const PkgVersion & pv, const FixedVersion & fv)
+    { return (fv.Compare(pv) > 0); }
+
+    inline bool operator > (const PkgVersion & pv, const FixedVersion & fv)
+    { return (fv.Compare(pv) < 0); }
+
+    inline bool operator == (const PkgVersion & pv, const FixedVersion & fv)
+    { return (fv.Compare(pv) == 0); }
+
+    inline bool operator != (const PkgVersion & pv, const FixedVersion & fv)
+    { return (fv.Compare(pv) != 0); }
+
+    inline bool operator < (const FixedVersion & fv, const PkgVersion & pv)
+    { return (fv.Compare(pv) < 0); }
+
+    inline bool operator > (const FixedVersion & fv, const PkgVersion & pv)
+    { return (fv.Compare(pv) > 0); }
+
+    inline bool operator == (const FixedVersion & fv, const PkgVersion & pv)
+    { return (fv.Compare(pv) == 0); }
+
+    inline bool operator != (const FixedVersion & fv, const PkgVersion & pv)
+    { return (fv.Compare(pv) != 0); }
+
+    //  These are checked wherever this header is included, so a change
+    //  to the comparison rules that breaks dpkg ordering won't compile.
+    static_assert(FixedVersion("1.0~rc1") < FixedVersion("1.0"));
+    static_assert(FixedVersion("1.0") < FixedVersion("1.0-1"));
+    static_assert(FixedVersion("1.0-1") < FixedVersion("1.0+dfsg-1"));
+    static_assert(FixedVersion("1.0a") < FixedVersion("1.0+"));
+    static_assert(FixedVersion("9.99") < FixedVersion("1:0.1"));
+    static_assert(FixedVersion("1.02") == FixedVersion("1.2-0"));
+    static_assert(FixedVersion("1.0-2-1") > FixedVersion("1.0-10"));
+    static_assert(FixedVersion("1.0-a-1") > FixedVersion("1.0-a.1"));
+    static_assert(FixedVersion("3.1-20221030-2").Release() == "2");
+    static_assert(FixedVersion("2:1.0-3ubuntu1").Epoch() == 2);
+    static_assert(FixedVersion("2:1.0-3ubuntu1").Release() == "3ubuntu1");
+
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBFIXEDVERSION_HH_
@@ -0,0 +1,668 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebPackageIndex.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::PackageIndex class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "DwmDebPackageIndex.hh"
+#include "DwmDebStatusDb.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //  Index file layout.  Everything is in host byte order (a file from
+    //  a host of the other byte order fails the byteOrder check), and
+    //  each section starts on an 8-byte boundary:
+    //
+    //    FileHeader
+    //    packages    numPackages x (uint32_t strOff, uint32_t strLen)
+    //    paths       numPaths x FileEntry, sorted by key
+    //    basenames   numBasenames x FileEntry, sorted by key
+    //    shared      numShared x (uint32_t start, uint32_t count)
+    //    sharedIds   numSharedIds x uint32_t package ids
+    //    strings     stringsLen bytes, not NUL-terminated
+    //
+    //  FileEntry values are package ids or k_shared | shared index, as in
+    //  the in-memory maps.
+    struct PackageIndex::FileHeader
+    {
+      char      magic[16];
+      uint32_t  byteOrder;
+      uint32_t  numPackages;
+      uint32_t  numPaths;
+      uint32_t  numBasenames;
+      uint32_t  numShared;
+      uint32_t  numSharedIds;
+      uint32_t  infoDirOff;
+      uint32_t  infoDirLen;
+      uint64_t  infoMtime;
+      uint64_t  statusMtime;
+      uint64_t  diversionsMtime;
+      uint64_t  packagesOff;
+      uint64_t  pathsOff;
+      uint64_t  basenamesOff;
+      uint64_t  sharedOff;
+      uint64_t  sharedIdsOff;
+      uint64_t  stringsOff;
+      uint64_t  stringsLen;
+    };
+
+    struct PackageIndex::FileEntry
+    {
+      uint32_t  strOff;
+      uint32_t  strLen;
+      uint32_t  value;
+    };
+
+    //  Bump the digit whenever the layout changes.
+    static const char      k_fileMagic[16] = "mkdebctl pkgix3";
+    static const uint32_t  k_byteOrder = 0x01020304;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static uint64_t Align8(uint64_t n)
+    {
+      return ((n + 7) & ~(uint64_t)7);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static bool MtimeNs(const string & path, uint64_t & mtime)
+    {
+      struct stat  st;
+      if (stat(path.c_str(), &st) != 0) {
+        return false;
+      }
+#ifdef __APPLE__
+      mtime = (st.st_mtimespec.tv_sec * 1000000000ULL)
+        + st.st_mtimespec.tv_nsec;
+#else
+      mtime = (st.st_mtim.tv_sec * 1000000000ULL) + st.st_mtim.tv_nsec;
+#endif
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static bool ReadFile(const string & path, string & contents)
+    {
+      ifstream  is(path, ios::binary);
+      if (! is) {
+        return false;
+      }
+      is.seekg(0, ios::end);
+      contents.resize(is.tellg());
+      is.seekg(0, ios::beg);
+      is.read(contents.data(), contents.size());
+      return (bool)is;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Where a diverted path's files go, and the package diverting it
+    //!  (':' for a local diversion).
+    //------------------------------------------------------------------------
+    struct Diversion
+    {
+      string_view  to;
+      string_view  by;
+    };
+
+    typedef unordered_map<string_view,Diversion>  DiversionMap;
+    
+    //------------------------------------------------------------------------
+    //!  The diversions file has three lines per diversion: the original
+    //!  path, the path it's diverted to, and the diverting package.
+    //------------------------------------------------------------------------
+    static void ParseDiversions(string_view s, DiversionMap & diversions)
+    {
+      string_view  lines[3];
+      int          n = 0;
+      while (! s.empty()) {
+        size_t  eol = s.find('\n');
+        lines[n++] = s.substr(0, eol);
+        s.remove_prefix((eol == string_view::npos) ? s.size() : eol + 1);
+        if (n == 3) {
+          if ((! lines[0].empty()) && (! lines[1].empty())) {
+            diversions[lines[0]] = { lines[1], lines[2] };
+          }
+          n = 0;
+        }
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PackageIndex::PackageIndex()
+        : _packages(), _lists(), _paths(), _basenames(), _shared(),
+          _map(nullptr), _mapSize(0), _hdr(nullptr)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PackageIndex::~PackageIndex()
+    {
+      Clear();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PackageIndex::Clear()
+    {
+      _packages.clear();
+      _lists.clear();
+      _paths.clear();
+      _basenames.clear();
+      _shared.clear();
+      if (_map) {
+        munmap((void *)_map, _mapSize);
+        _map = nullptr;
+      }
+      _mapSize = 0;
+      _hdr = nullptr;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::Load(const string & infoDir)
+    {
+      Clear();
+
+      filesystem::path  dir(infoDir);
+      if (! dir.has_filename()) {
+        dir = dir.parent_path();
+      }
+      DiversionMap  diversions;
+      string        contents;
+      if (ReadFile((dir.parent_path() / "diversions").string(), contents)) {
+        _lists.push_back(move(contents));
+        ParseDiversions(_lists.back(), diversions);
+      }
+      StatusDb  statusDb;
+      statusDb.Load((dir.parent_path() / "status").string());
+      
+      //  List files are named 'package.list' or 'package:arch.list'.
+      //  Sorting them makes package ids, and hence the order of owners,
+      //  follow package names.
+      vector<pair<string,string>>  lists;
+      error_code                   ec;
+      for (const auto & entry : filesystem::directory_iterator(infoDir, ec)) {
+        if (entry.path().extension() == ".list") {
+          lists.push_back({entry.path().stem().string(),
+                           entry.path().string()});
+        }
+      }
+      sort(lists.begin(), lists.end());
+      
+      for (const auto & [pkg, path] : lists) {
+        if (! ReadFile(path, contents)) {
+          continue;
+        }
+        string_view  pkgName(pkg);
+        pkgName = pkgName.substr(0, pkgName.find(':'));
+        uint32_t  id = _packages.size();
+        string    arch;
+        if ((pkgName.size() == pkg.size())
+            && statusDb.Architecture(pkgName, arch)) {
+          _packages.push_back(pkg + ':' + arch);
+        }
+        else {
+          _packages.push_back(pkg);
+        }
+        _lists.push_back(move(contents));
+        string_view  s(_lists.back());
+        while (! s.empty()) {
+          size_t       eol = s.find('\n');
+          string_view  line = s.substr(0, eol);
+          s.remove_prefix((eol == string_view::npos) ? s.size() : eol + 1);
+          if (line.empty() || (line == "/.")) {
+            continue;
+          }
+          auto  div = diversions.find(line);
+          if ((div != diversions.end()) && (div->second.by != pkgName)) {
+            line = div->second.to;
+          }
+          Add(_paths, line, id);
+          string_view  base = line.substr(line.rfind('/') + 1);
+          if (! base.empty()) {
+            Add(_basenames, base, id);
+          }
+        }
+      }
+      return IsLoaded();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::Load(const string & infoDir, const string & indexPath)
+    {
+      //  The mtimes are taken before reading anything, so if dpkg changes
+      //  the database while we're reading it, the index file we write
+      //  will be out of date and rebuilt next time.
+      filesystem::path  dir(infoDir);
+      if (! dir.has_filename()) {
+        dir = dir.parent_path();
+      }
+      DbMtimes  mtimes;
+      bool      haveMtimes =
+        (MtimeNs(infoDir, mtimes.info)
+         && MtimeNs((dir.parent_path() / "status").string(), mtimes.status));
+      if (! MtimeNs((dir.parent_path() / "diversions").string(),
+                    mtimes.diversions)) {
+        mtimes.diversions = 0;
+      }
+      if (haveMtimes && MapFile(indexPath, mtimes, infoDir)) {
+        return true;
+      }
+      if (! Load(infoDir)) {
+        return false;
+      }
+      if (haveMtimes) {
+        Save(indexPath, mtimes, infoDir);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PackageIndex::NumPackages() const
+    {
+      return (_map ? _hdr->numPackages : _packages.size());
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PackageIndex::NumPaths() const
+    {
+      return (_map ? _hdr->numPaths : _paths.size());
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::FindPath(string_view path, vector<string> & owners,
+                                string_view arch) const
+    {
+      owners.clear();
+      if (_map) {
+        uint32_t  value;
+        if (MappedFind(_hdr->pathsOff, _hdr->numPaths, path, value)) {
+          GetOwners(value, arch, owners);
+        }
+      }
+      else {
+        auto  it = _paths.find(path);
+        if (it != _paths.end()) {
+          GetOwners(it->second, arch, owners);
+        }
+      }
+      return (! owners.empty());
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::FindBasename(string_view name,
+                                    vector<string> & owners,
+                                    string_view arch) const
+    {
+      owners.clear();
+      if (_map) {
+        uint32_t  value;
+        if (MappedFind(_hdr->basenamesOff, _hdr->numBasenames, name, value)) {
+          GetOwners(value, arch, owners);
+        }
+      }
+      else {
+        auto  it = _basenames.find(name);
+        if (it != _basenames.end()) {
+          GetOwners(it->second, arch, owners);
+        }
+      }
+      return (! owners.empty());
+    }
+
+    //------------------------------------------------------------------------
+    //!  Packages are added in id order, so shared owner lists stay sorted
+    //!  and a repeated key within a package only has to be checked
+    //!  against the last owner.
+    //------------------------------------------------------------------------
+    void PackageIndex::Add(Map & map, string_view key, uint32_t pkg)
+    {
+      auto  [it, added] = map.emplace(key, pkg);
+      if (! added) {
+        uint32_t  & value = it->second;
+        if (! (value & k_shared)) {
+          if (value != pkg) {
+            _shared.push_back({value, pkg});
+            value = k_shared | (_shared.size() - 1);
+          }
+        }
+        else {
+          auto  & shared = _shared[value & ~k_shared];
+          if (shared.back() != pkg) {
+            shared.push_back(pkg);
+          }
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string_view PackageIndex::PackageName(uint32_t id) const
+    {
+      if (_map) {
+        const uint32_t  *packages =
+          (const uint32_t *)(_map + _hdr->packagesOff);
+        return MappedString(packages[id * 2], packages[(id * 2) + 1]);
+      }
+      return _packages[id];
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PackageIndex::GetOwners(uint32_t value, string_view arch,
+                                 vector<string> & owners) const
+    {
+      auto  addOwner = [&] (uint32_t pkg)
+      {
+        string_view  name = PackageName(pkg);
+        size_t       colon = name.rfind(':');
+        if (arch.empty() || (colon == string_view::npos)
+            || (name.substr(colon + 1) == arch)
+            || (name.substr(colon + 1) == "all")) {
+          owners.emplace_back(name);
+        }
+      };
+      if (! (value & k_shared)) {
+        addOwner(value);
+      }
+      else if (_map) {
+        const uint32_t  *shared = (const uint32_t *)(_map + _hdr->sharedOff)
+                                  + ((value & ~k_shared) * 2);
+        const uint32_t  *ids = (const uint32_t *)(_map + _hdr->sharedIdsOff);
+        for (uint32_t i = 0; i < shared[1]; ++i) {
+          addOwner(ids[shared[0] + i]);
+        }
+      }
+      else {
+        for (auto pkg : _shared[value & ~k_shared]) {
+          addOwner(pkg);
+        }
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string_view PackageIndex::MappedString(uint32_t off, uint32_t len) const
+    {
+      return string_view((const char *)_map + _hdr->stringsOff + off, len);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::MappedFind(uint64_t tableOff, uint32_t count,
+                                  string_view key, uint32_t & value) const
+    {
+      const FileEntry  *begin = (const FileEntry *)(_map + tableOff);
+      const FileEntry  *end = begin + count;
+      const FileEntry  *it =
+        lower_bound(begin, end, key,
+                    [this] (const FileEntry & e, string_view k)
+                    { return (MappedString(e.strOff, e.strLen) < k); });
+      if ((it != end) && (MappedString(it->strOff, it->strLen) == key)) {
+        value = it->value;
+        return true;
+      }
+      return false;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Maps the index file and checks that it's current and intact.
+    //!  Every offset and id in it is checked here so lookups don't have
+    //!  to.
+    //------------------------------------------------------------------------
+    bool PackageIndex::MapFile(const string & indexPath,
+                               const DbMtimes & mtimes,
+                               const string & infoDir)
+    {
+      int  fd = open(indexPath.c_str(), O_RDONLY);
+      if (fd < 0) {
+        return false;
+      }
+      struct stat  st;
+      void        *addr = MAP_FAILED;
+      if ((fstat(fd, &st) == 0) && (st.st_size >= (off_t)sizeof(FileHeader))) {
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      close(fd);
+      if (addr == MAP_FAILED) {
+        return false;
+      }
+      _map = (const uint8_t *)addr;
+      _mapSize = st.st_size;
+      _hdr = (const FileHeader *)_map;
+
+      const FileHeader  & h = *_hdr;
+      auto  fits = [&] (uint64_t off, uint64_t count, uint64_t size)
+      {
+        return ((off % 8) == 0) && (off <= _mapSize)
+          && (count <= ((_mapSize - off) / size));
+      };
+      bool  ok = (memcmp(h.magic, k_fileMagic, sizeof(h.magic)) == 0)
+        && (h.byteOrder == k_byteOrder)
+        && (h.infoMtime == mtimes.info) && (h.statusMtime == mtimes.status)
+        && (h.diversionsMtime == mtimes.diversions)
+        && (h.numPackages > 0) && (h.numPackages < k_shared)
+        && (h.numShared < k_shared)
+        && fits(h.packagesOff, h.numPackages, 8)
+        && fits(h.pathsOff, h.numPaths, sizeof(FileEntry))
+        && fits(h.basenamesOff, h.numBasenames, sizeof(FileEntry))
+        && fits(h.sharedOff, h.numShared, 8)
+        && fits(h.sharedIdsOff, h.numSharedIds, 4)
+        && fits(h.stringsOff, h.stringsLen, 1)
+        && (h.stringsLen < 0xffffffff)
+        && (((uint64_t)h.infoDirOff + h.infoDirLen) <= h.stringsLen)
+        && (MappedString(h.infoDirOff, h.infoDirLen) == infoDir);
+      
+      auto  strOk = [&] (uint64_t off, uint64_t len)
+      { return ((off + len) <= h.stringsLen); };
+      auto  valueOk = [&] (uint32_t value)
+      {
+        return (value & k_shared) ? ((value & ~k_shared) < h.numShared)
+                                  : (value < h.numPackages);
+      };
+      const uint32_t  *packages = (const uint32_t *)(_map + h.packagesOff);
+      for (uint32_t i = 0; ok && (i < h.numPackages); ++i) {
+        ok = strOk(packages[i * 2], packages[(i * 2) + 1]);
+      }
+      for (uint64_t tableOff : { h.pathsOff, h.basenamesOff }) {
+        uint32_t          count = ((tableOff == h.pathsOff) ? h.numPaths
+                                   : h.numBasenames);
+        const FileEntry  *entries = (const FileEntry *)(_map + tableOff);
+        for (uint32_t i = 0; ok && (i < count); ++i) {
+          ok = strOk(entries[i].strOff, entries[i].strLen)
+            && valueOk(entries[i].value);
+        }
+      }
+      const uint32_t  *shared = (const uint32_t *)(_map + h.sharedOff);
+      for (uint32_t i = 0; ok && (i < h.numShared); ++i) {
+        ok = (((uint64_t)shared[i * 2] + shared[(i * 2) + 1])
+              <= h.numSharedIds);
+      }
+      const uint32_t  *ids = (const uint32_t *)(_map + h.sharedIdsOff);
+      for (uint32_t i = 0; ok && (i < h.numSharedIds); ++i) {
+        ok = (ids[i] < h.numPackages);
+      }
+      if (! ok) {
+        Clear();
+      }
+      return ok;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PackageIndex::Save(const string & indexPath, const DbMtimes & mtimes,
+                            const string & infoDir) const
+    {
+      static atomic<uint64_t>  tmpSeq(0);
+      
+      string  strings;
+      auto  addString = [&strings] (string_view s, uint32_t *p)
+      {
+        p[0] = strings.size();
+        p[1] = s.size();
+        strings.append(s);
+      };
+      vector<uint32_t>  packages(_packages.size() * 2);
+      for (size_t i = 0; i < _packages.size(); ++i) {
+        addString(_packages[i], &packages[i * 2]);
+      }
+      auto  makeTable = [&addString] (const Map & map)
+      {
+        vector<pair<string_view,uint32_t>>  sorted(map.begin(), map.end());
+        sort(sorted.begin(), sorted.end());
+        vector<FileEntry>  rc(sorted.size());
+        for (size_t i = 0; i < sorted.size(); ++i) {
+          addString(sorted[i].first, &rc[i].strOff);
+          rc[i].value = sorted[i].second;
+        }
+        return rc;
+      };
+      vector<FileEntry>  paths = makeTable(_paths);
+      vector<FileEntry>  basenames = makeTable(_basenames);
+      vector<uint32_t>   shared, sharedIds;
+      for (const auto & owners : _shared) {
+        shared.push_back(sharedIds.size());
+        shared.push_back(owners.size());
+        sharedIds.insert(sharedIds.end(), owners.begin(), owners.end());
+      }
+      FileHeader  h;
+      memset(&h, 0, sizeof(h));
+      addString(infoDir, &h.infoDirOff);
+      if (strings.size() >= 0xffffffff) {
+        return false;
+      }
+      memcpy(h.magic, k_fileMagic, sizeof(h.magic));
+      h.byteOrder = k_byteOrder;
+      h.numPackages = _packages.size();
+      h.numPaths = paths.size();
+      h.numBasenames = basenames.size();
+      h.numShared = _shared.size();
+      h.numSharedIds = sharedIds.size();
+      h.infoMtime = mtimes.info;
+      h.statusMtime = mtimes.status;
+      h.diversionsMtime = mtimes.diversions;
+      h.packagesOff = Align8(sizeof(h));
+      h.pathsOff = Align8(h.packagesOff + (packages.size() * 4));
+      h.basenamesOff = Align8(h.pathsOff + (paths.size() * sizeof(FileEntry)));
+      h.sharedOff = Align8(h.basenamesOff
+                           + (basenames.size() * sizeof(FileEntry)));
+      h.sharedIdsOff = Align8(h.sharedOff + (shared.size() * 4));
+      h.stringsOff = Align8(h.sharedIdsOff + (sharedIds.size() * 4));
+      h.stringsLen = strings.size();
+      
+      string  tmpPath = indexPath + ".tmp." + to_string(getpid()) + '.'
+        + to_string(tmpSeq++);
+      bool    rc = false;
+      {
+        ofstream  os(tmpPath, ios::binary);
+        if (os) {
+          auto  writeAt = [&os] (uint64_t off, const void *p, size_t len)
+          {
+            static const char  zeros[8] = { 0 };
+            os.write(zeros, off - os.tellp());
+            os.write((const char *)p, len);
+          };
+          os.write((const char *)&h, sizeof(h));
+          writeAt(h.packagesOff, packages.data(), packages.size() * 4);
+          writeAt(h.pathsOff, paths.data(), paths.size() * sizeof(FileEntry));
+          writeAt(h.basenamesOff, basenames.data(),
+                  basenames.size() * sizeof(FileEntry));
+          writeAt(h.sharedOff, shared.data(), shared.size() * 4);
+          writeAt(h.sharedIdsOff, sharedIds.data(), sharedIds.size() * 4);
+          writeAt(h.stringsOff, strings.data(), strings.size());
+          rc = os.good();
+        }
+      }
+      if (rc) {
+        rc = (rename(tmpPath.c_str(), indexPath.c_str()) == 0);
+      }
+      if (! rc) {
+        unlink(tmpPath.c_str());
+      }
+      return rc;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
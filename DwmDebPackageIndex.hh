@@ -0,0 +1,207 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebPackageIndex.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::PackageIndex class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBPACKAGEINDEX_HH_
+#define _DWMDEBPACKAGEINDEX_HH_
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  An in-memory index of which installed packages own which files,
+    //!  built from the *.list files in the dpkg info directory.  Lookups
+    //!  are by full path or by basename, and are hash table probes; this
+    //!  replaces running 'dpkg -S' once per file.  Package names are
+    //!  qualified with their architecture (e.g. 'zlib1g:amd64'): dpkg
+    //!  names the list files of Multi-Arch: same packages that way, and
+    //!  the status file next to the info directory gives it for the
+    //!  rest.  Lookups may be restricted to one architecture, so that on
+    //!  a multiarch system a 64-bit binary's libraries aren't attributed
+    //!  to the packages of their 32-bit counterparts.
+    //!
+    //!  Diversions (from the 'diversions' file next to the info
+    //!  directory) are applied while loading: a diverted path is owned
+    //!  only by the package that diverted it, and the other packages that
+    //!  list it own the path it was diverted to instead, which is where
+    //!  dpkg put their copy.  A local diversion (by the administrator)
+    //!  moves every package's copy.
+    //!
+    //!  The index can also be kept in a file, so that repeated runs against
+    //!  an unchanged dpkg database don't have to read the list files
+    //!  again.  The file holds sorted path and basename tables and a
+    //!  string table, and is used in place with mmap() and binary search.
+    //!  It records the modification times of the info directory and the
+    //!  status file next to it (dpkg changes both whenever a package is
+    //!  installed or removed) and of the diversions file, and is rebuilt
+    //!  when any of them changes.
+    //!
+    //!  Once loaded, an index is only read, so it may be shared by any
+    //!  number of threads.
+    //------------------------------------------------------------------------
+    class PackageIndex
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      PackageIndex();
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ~PackageIndex();
+      
+      PackageIndex(const PackageIndex &) = delete;
+      PackageIndex & operator = (const PackageIndex &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Reads all of the *.list files in @c infoDir.  Returns false if
+      //!  @c infoDir can't be read or has no list files.
+      //----------------------------------------------------------------------
+      bool Load(const std::string & infoDir = "/var/lib/dpkg/info");
+
+      //----------------------------------------------------------------------
+      //!  Maps the index file at @c indexPath if it's current for
+      //!  @c infoDir.  Otherwise loads from @c infoDir and writes a new
+      //!  index file (via a temporary file and rename(), so concurrent
+      //!  runs may share it).  Failing to write the index file is not an
+      //!  error.  Returns false if neither source could be used.
+      //----------------------------------------------------------------------
+      bool Load(const std::string & infoDir, const std::string & indexPath);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if Load() succeeded.
+      //----------------------------------------------------------------------
+      bool IsLoaded() const
+      { return ((! _packages.empty()) || _map); }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the index is in use from an index file.
+      //----------------------------------------------------------------------
+      bool IsMapped() const
+      { return (_map != nullptr); }
+      
+      //----------------------------------------------------------------------
+      //!  Fills @c owners with the packages that own @c path, in package
+      //!  name order.  If @c arch is not empty, only packages for that
+      //!  architecture (or 'all', or of unknown architecture) are
+      //!  included.  Returns false if no such package owns it.
+      //----------------------------------------------------------------------
+      bool FindPath(std::string_view path, std::vector<std::string> & owners,
+                    std::string_view arch = std::string_view()) const;
+
+      //----------------------------------------------------------------------
+      //!  Fills @c owners with the packages that own a file named
+      //!  @c name, in any directory, in package name order.  @c arch is
+      //!  as for FindPath().  Returns false if there are none.
+      //----------------------------------------------------------------------
+      bool FindBasename(std::string_view name,
+                        std::vector<std::string> & owners,
+                        std::string_view arch = std::string_view()) const;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      size_t NumPackages() const;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      size_t NumPaths() const;
+      
+    private:
+      //  Owners are stored as a single package id, which is all most
+      //  paths have.  Paths with several owners (mostly directories)
+      //  have k_shared set and the rest of the value indexes _shared.
+      static constexpr uint32_t  k_shared = 0x80000000;
+      
+      typedef std::unordered_map<std::string_view,uint32_t>  Map;
+
+      std::vector<std::string>               _packages;
+      std::deque<std::string>                _lists;
+      Map                                    _paths;
+      Map                                    _basenames;
+      std::vector<std::vector<uint32_t>>     _shared;
+
+      //  Index file layout; see DwmDebPackageIndex.cc.
+      struct FileHeader;
+      struct FileEntry;
+
+      //  What an index file is checked against.  A missing diversions
+      //  file has mtime 0.
+      struct DbMtimes
+      {
+        uint64_t  info;
+        uint64_t  status;
+        uint64_t  diversions;
+      };
+
+      const uint8_t                         *_map;
+      size_t                                 _mapSize;
+      const FileHeader                      *_hdr;
+      
+      void Clear();
+      void Add(Map & map, std::string_view key, uint32_t pkg);
+      std::string_view PackageName(uint32_t id) const;
+      void GetOwners(uint32_t value, std::string_view arch,
+                     std::vector<std::string> & owners) const;
+      bool MapFile(const std::string & indexPath, const DbMtimes & mtimes,
+                   const std::string & infoDir);
+      bool Save(const std::string & indexPath, const DbMtimes & mtimes,
+                const std::string & infoDir) const;
+      bool MappedFind(uint64_t tableOff, uint32_t count,
+                      std::string_view key, uint32_t & value) const;
+      std::string_view MappedString(uint32_t off, uint32_t len) const;
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBPACKAGEINDEX_HH_
@@ -39,10 +39,14 @@
 //!  \brief Dwm::Deb::PkgDepend class implementation
 //---------------------------------------------------------------------------
 
-#include <cstdio>
+#include <map>
+#include <mutex>
 #include <regex>
+#include <sstream>
 
 #include "DwmDebPkgDepend.hh"
+#include "DwmDebProcessRunner.hh"
+#include "DwmDebStatusDb.hh"
 
 namespace Dwm {
 
@@ -77,35 +81,79 @@ namespace Dwm {
       return _version;
     }
   
+    //  Installed versions, shared by all callers of InstalledVersion().
+    static mutex                   g_installedMtx;
+    static string                  g_adminDir("/var/lib/dpkg");
+    static StatusDb                g_statusDb;
+    static bool                    g_triedStatusDb = false;
+    static map<string,PkgVersion>  g_installed;
+    
     //------------------------------------------------------------------------
-    //!  
+    //!  Asks 'dpkg -s' for the installed version of @c pkg.  Only used
+    //!  if the status file can't be read.
     //------------------------------------------------------------------------
-    PkgVersion PkgDepend::InstalledVersion(const string & pkg)
+    static PkgVersion DpkgInstalledVersion(const string & pkg)
     {
-      PkgVersion  rc;
-    
-      string  cmd("dpkg -s ");
-      cmd += pkg;
-      FILE  *cmdpipe = popen(cmd.c_str(), "r");
-      if (cmdpipe) {
-        regex   rgx("^Version[:][ \\t]*([^ \\t\\n]+)",
-                    regex::ECMAScript|regex::optimize);
-        smatch  sm;
-        char    line[4096];
-        while (fgets(line, 4096, cmdpipe) != NULL) {
-          string  s(line);
-          if (regex_search(s, sm, rgx)) {
-            if (sm.size() == 2) {
-              rc.FromString(sm[1].str());
-              break;
-            }
+      PkgVersion             rc;
+      ProcessRunner          runner(1);
+      ProcessRunner::Result  result;
+      runner.Run({{"dpkg", "--admindir=" + g_adminDir, "-s", pkg}, 60000},
+                 result);
+      regex          rgx("^Version[:][ \\t]*([^ \\t\\n]+)",
+                         regex::ECMAScript|regex::optimize);
+      smatch         sm;
+      istringstream  is(result.output);
+      string         s;
+      while (getline(is, s)) {
+        if (regex_search(s, sm, rgx)) {
+          if (sm.size() == 2) {
+            rc.FromString(sm[1].str());
+            break;
           }
         }
-        pclose(cmdpipe);
       }
       return rc;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PkgDepend::AdminDir(const string & dir)
+    {
+      lock_guard<mutex>  lck(g_installedMtx);
+      g_adminDir = dir;
+      g_statusDb = StatusDb();
+      g_triedStatusDb = false;
+      g_installed.clear();
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  The status file is read on the first call.  Results are memoized,
+    //!  so each package costs one lookup (or one 'dpkg -s') no matter how
+    //!  many times it's asked for.
+    //------------------------------------------------------------------------
+    PkgVersion PkgDepend::InstalledVersion(const string & pkg)
+    {
+      lock_guard<mutex>  lck(g_installedMtx);
+      auto  it = g_installed.find(pkg);
+      if (it == g_installed.end()) {
+        if (! g_triedStatusDb) {
+          g_statusDb.Load(g_adminDir + "/status");
+          g_triedStatusDb = true;
+        }
+        PkgVersion  rc;
+        if (g_statusDb.IsLoaded()) {
+          g_statusDb.InstalledVersion(pkg, rc);
+        }
+        else {
+          rc = DpkgInstalledVersion(pkg);
+        }
+        it = g_installed.emplace(pkg, rc).first;
+      }
+      return it->second;
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -82,6 +82,12 @@ namespace Dwm {
     
       static PkgVersion InstalledVersion(const std::string & pkg);
 
+      //----------------------------------------------------------------------
+      //!  Sets the dpkg admin directory InstalledVersion() reads from
+      //!  (default /var/lib/dpkg), e.g. one inside a sysroot.
+      //----------------------------------------------------------------------
+      static void AdminDir(const std::string & dir);
+
       bool operator < (const PkgDepend & dpd) const;
 
       bool operator == (const PkgDepend & dpd) const;
@@ -39,10 +39,8 @@
 //!  \brief Dwm::Deb::PkgVersion class implementation
 //---------------------------------------------------------------------------
 
-#include <cstdlib>
-#include <regex>
-
 #include "DwmDebPkgVersion.hh"
+#include "DwmDebVersionCompare.hh"
 
 namespace Dwm {
 
@@ -53,56 +51,15 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool PkgVersion::FromString(const std::string & s)
+    bool PkgVersion::FromString(std::string_view s)
     {
-      _epoch = 0;
-      _version.clear();
-      _release.clear();
-
-      bool   rc = false;
-    
-      static regex  full("([0-9]+)[:]([^-]+)\\-(.+)",
-                         regex::ECMAScript|regex::optimize);
-      smatch        sm;
-      if (regex_match(s, sm, full)) {
-        if (sm.size() == 4) {
-          _epoch = atoi(sm[1].str().c_str());
-          _version = sm[2].str();
-          _release = sm[3].str();
-          rc = true;
-        }
-      }
-      else {
-        static regex  epochvers("([0-9]+)[:]([^-]+)",
-                                regex::ECMAScript|regex::optimize);
-        if (regex_match(s, sm, epochvers)) {
-          if (sm.size() == 3) {
-            _epoch = atoi(sm[1].str().c_str());
-            _version = sm[2].str();
-            rc = true;
-          }
-        }
-        else {
-          static regex  versrelease("([^-]+)\\-(.+)",
-                                    regex::ECMAScript|regex::optimize);
-          if (regex_match(s, sm, versrelease)) {
-            if (sm.size() == 3) {
-              _version = sm[1].str();
-              _release = sm[2].str();
-              rc = true;
-            }
-          }
-          else {
-            if (! s.empty()) {
-              _version = s;
-              rc = true;
-            }
-          }
-        }
-      }
+      string_view  upstream, release;
+      bool  rc = VersionCompare::Split(s, _epoch, upstream, release);
+      _version = string(upstream);
+      _release = release;
+      UpdateKey();
       return rc;
     }
-  
 
     //------------------------------------------------------------------------
     //!  
@@ -110,6 +67,7 @@ namespace Dwm {
     int PkgVersion::Epoch(int epoch)
     {
       _epoch = epoch;
+      UpdateKey();
       return _epoch;
     }
 
@@ -119,6 +77,7 @@ namespace Dwm {
     const VersionString & PkgVersion::Version(const VersionString & version)
     {
       _version = version;
+      UpdateKey();
       return _version;
     }
   
@@ -128,24 +87,24 @@ namespace Dwm {
     const std::string & PkgVersion::Release(const std::string & release)
     {
       _release = release;
+      UpdateKey();
       return _release;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    int PkgVersion::Compare(const PkgVersion & dpv) const
+    {
+      return _key.compare(dpv._key);
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     bool PkgVersion::operator > (const PkgVersion & dpv) const
     {
-      bool  rc = false;
-      if (_epoch > dpv._epoch) {
-        rc = true;
-      }
-      else if (_epoch == dpv._epoch) {
-        if (_version > dpv._version) {
-          rc = true;
-        }
-      }
-      return rc;
+      return (Compare(dpv) > 0);
     }
 
     //------------------------------------------------------------------------
@@ -153,26 +112,15 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool PkgVersion::operator < (const PkgVersion & dpv) const
     {
-      bool  rc = false;
-      if (_epoch < dpv._epoch) {
-        rc = true;
-      }
-      else if (_epoch == dpv._epoch) {
-        if (_version < dpv._version) {
-          rc = true;
-        }
-      }
-      return rc;
+      return (Compare(dpv) < 0);
     }
-  
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     bool PkgVersion::operator == (const PkgVersion & dpv) const
     {
-      return ((_epoch == dpv._epoch)
-              && (_version == dpv._version)
-              && (_release == dpv._release));
+      return (Compare(dpv) == 0);
     }
 
     //------------------------------------------------------------------------
@@ -180,11 +128,18 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool PkgVersion::operator != (const PkgVersion & dpv) const
     {
-      return ((_epoch != dpv._epoch)
-              || (_version != dpv._version)
-              || (_release != dpv._release));
+      return (Compare(dpv) != 0);
     }
-  
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PkgVersion::UpdateKey()
+    {
+      _key.clear();
+      VersionCompare::AppendKey(_key, _epoch, _version.String(), _release);
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
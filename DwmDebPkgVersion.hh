@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "DwmDebVersionString.hh"
 
@@ -62,34 +63,53 @@ namespace Dwm {
       //!  
       //----------------------------------------------------------------------
       PkgVersion()
-          : _epoch(0), _version(), _release()
-      {}
+          : _epoch(0), _version(), _release(), _key()
+      { UpdateKey(); }
 
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
       PkgVersion(const PkgVersion & dpv) = default;
+
+      //----------------------------------------------------------------------
+      //!  Moves steal the strings, including the sort key, so sorting
+      //!  and container growth don't allocate.
+      //----------------------------------------------------------------------
+      PkgVersion(PkgVersion && dpv) = default;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      PkgVersion & operator = (const PkgVersion & dpv) = default;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      PkgVersion & operator = (PkgVersion && dpv) = default;
     
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
       PkgVersion(const std::string & version,
                  const std::string & release = "")
-          : _epoch(0), _version(version), _release(release)
-      {}
+          : _epoch(0), _version(version), _release(release), _key()
+      { UpdateKey(); }
 
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
       PkgVersion(int epoch, const std::string & version,
                  const std::string & release = "")
-          : _epoch(epoch), _version(version), _release(release)
-      {}
+          : _epoch(epoch), _version(version), _release(release), _key()
+      { UpdateKey(); }
 
       //----------------------------------------------------------------------
-      //!  
+      //!  Parses @c s as [epoch:]version[-release] in one pass.  The
+      //!  release follows the last '-'; if there's no usable epoch or
+      //!  release, all of @c s is the version.  Returns false if @c s is
+      //!  empty.
       //----------------------------------------------------------------------
-      bool FromString(const std::string & s);
+      bool FromString(std::string_view s);
     
       //----------------------------------------------------------------------
       //!  
@@ -121,6 +141,19 @@ namespace Dwm {
       //----------------------------------------------------------------------
       const std::string & Release(const std::string & release);
 
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      int Compare(const PkgVersion & dpv) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the sort key for the version, built whenever the version
+      //!  changes.  Keys compare with memcmp() the way dpkg compares
+      //!  versions, so they can be hashed or used as container keys
+      //!  directly.  See VersionCompare::AppendKey().
+      //----------------------------------------------------------------------
+      const std::string & Key() const  { return _key; }
+
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
@@ -151,11 +184,28 @@ namespace Dwm {
       int            _epoch;
       VersionString  _version;
       std::string    _release;
-    
+      std::string    _key;
+
+      void UpdateKey();
     };
 
   }  // namespace Deb
   
 }  // namespace Dwm
 
+//----------------------------------------------------------------------------
+//!  Hashes a PkgVersion by its sort key, so versions dpkg considers equal
+//!  (e.g. '1.0' and '1.00') hash equal.
+//----------------------------------------------------------------------------
+namespace std {
+
+  template <>
+  struct hash<Dwm::Deb::PkgVersion>
+  {
+    size_t operator () (const Dwm::Deb::PkgVersion & v) const noexcept
+    { return hash<string>()(v.Key()); }
+  };
+
+}  // namespace std
+
 #endif  // _DWMDEBPKGVERSION_HH_
@@ -0,0 +1,351 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebProcessRunner.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ProcessRunner class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/wait.h>
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <signal.h>
+  #include <spawn.h>
+  #include <unistd.h>
+#ifdef __linux__
+  #include <sys/epoll.h>
+#endif
+}
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#include "DwmDebProcessRunner.hh"
+
+extern char **environ;
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    typedef chrono::steady_clock  Clock;
+
+    namespace {
+
+      //----------------------------------------------------------------------
+      //!  A command we've started and haven't reaped.
+      //----------------------------------------------------------------------
+      struct Running
+      {
+        size_t             idx;
+        pid_t              pid;
+        int                fd;
+        bool               hasDeadline;
+        Clock::time_point  deadline;
+      };
+
+    }  // anonymous namespace
+    
+    //------------------------------------------------------------------------
+    //!  Both ends of the pipe are close-on-exec so that children started
+    //!  by other threads don't inherit them (which would keep us from
+    //!  seeing EOF).  The dup2() in the child clears it on its stdout.
+    //------------------------------------------------------------------------
+    static bool MakePipe(int fds[2])
+    {
+#ifdef __linux__
+      return (pipe2(fds, O_CLOEXEC) == 0);
+#else
+      if (pipe(fds) != 0) {
+        return false;
+      }
+      fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+      fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+      return true;
+#endif
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Starts @c argv with its stdout on a new non-blocking pipe, whose
+    //!  read end is returned in @c fd.
+    //------------------------------------------------------------------------
+    static bool Spawn(const vector<string> & argv, pid_t & pid, int & fd)
+    {
+      if (argv.empty()) {
+        return false;
+      }
+      int  fds[2];
+      if (! MakePipe(fds)) {
+        return false;
+      }
+      posix_spawn_file_actions_t  actions;
+      posix_spawn_file_actions_init(&actions);
+      posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+      posix_spawn_file_actions_adddup2(&actions, fds[1], 1);
+      posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+
+      posix_spawnattr_t  attr;
+      posix_spawnattr_init(&attr);
+      sigset_t  sigs;
+      sigemptyset(&sigs);
+      posix_spawnattr_setsigmask(&attr, &sigs);
+      sigaddset(&sigs, SIGPIPE);
+      posix_spawnattr_setsigdefault(&attr, &sigs);
+      posix_spawnattr_setflags(&attr,
+                               POSIX_SPAWN_SETSIGMASK|POSIX_SPAWN_SETSIGDEF);
+
+      vector<char *>  args;
+      for (const auto & arg : argv) {
+        args.push_back(const_cast<char *>(arg.c_str()));
+      }
+      args.push_back(nullptr);
+      int  err = posix_spawnp(&pid, args[0], &actions, &attr, args.data(),
+                              environ);
+      posix_spawnattr_destroy(&attr);
+      posix_spawn_file_actions_destroy(&actions);
+      close(fds[1]);
+      if (err != 0) {
+        close(fds[0]);
+        return false;
+      }
+      fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+      fd = fds[0];
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Reads what's available from @c fd into @c output.  Returns true
+    //!  once there's nothing more to read (EOF or an error).
+    //------------------------------------------------------------------------
+    static bool Drain(int fd, string & output)
+    {
+      char  buf[16384];
+      for (;;) {
+        ssize_t  n = read(fd, buf, sizeof(buf));
+        if (n > 0) {
+          output.append(buf, n);
+        }
+        else if (n == 0) {
+          return true;
+        }
+        else if (errno == EINTR) {
+          continue;
+        }
+        else {
+          return ((errno != EAGAIN) && (errno != EWOULDBLOCK));
+        }
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  Closes the pipe of @c r and reaps it, killing it first if it
+    //!  timed out.  A child can close its stdout and keep running, so
+    //!  until its deadline we only poll for its exit; past the deadline
+    //!  it's killed like any other command that timed out.
+    //------------------------------------------------------------------------
+    static void Finish(const Running & r, ProcessRunner::Result & result)
+    {
+      close(r.fd);
+      if (result.timedOut) {
+        kill(r.pid, SIGKILL);
+      }
+      int  status;
+      int  waitFlags = (r.hasDeadline && (! result.timedOut)) ? WNOHANG : 0;
+      auto  pause = chrono::milliseconds(1);
+      for (;;) {
+        pid_t  pid = waitpid(r.pid, &status, waitFlags);
+        if (pid == r.pid) {
+          break;
+        }
+        if (pid < 0) {
+          if (errno != EINTR) {
+            return;
+          }
+        }
+        else if (Clock::now() >= r.deadline) {
+          result.timedOut = true;
+          kill(r.pid, SIGKILL);
+          waitFlags = 0;
+        }
+        else {
+          this_thread::sleep_for(pause);
+          pause = min(pause * 2, chrono::milliseconds(50));
+        }
+      }
+      if ((! result.timedOut) && WIFEXITED(status)) {
+        result.exited = true;
+        result.exitStatus = WEXITSTATUS(status);
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ProcessRunner::ProcessRunner(size_t maxRunning)
+        : _maxRunning(maxRunning)
+    {
+      if (_maxRunning == 0) {
+        _maxRunning = max(thread::hardware_concurrency(), 1U);
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ProcessRunner::Run(const vector<Command> & commands,
+                            vector<Result> & results) const
+    {
+      results.assign(commands.size(), Result());
+#ifdef __linux__
+      int  epfd = epoll_create1(EPOLL_CLOEXEC);
+      if (epfd < 0) {
+        return false;
+      }
+#endif
+      vector<Running>  running;
+      size_t           next = 0;
+      while ((next < commands.size()) || (! running.empty())) {
+        while ((running.size() < _maxRunning) && (next < commands.size())) {
+          Running  r;
+          r.idx = next++;
+          if (! Spawn(commands[r.idx].argv, r.pid, r.fd)) {
+            continue;
+          }
+          r.hasDeadline = (commands[r.idx].timeoutMs > 0);
+          if (r.hasDeadline) {
+            r.deadline = Clock::now()
+              + chrono::milliseconds(commands[r.idx].timeoutMs);
+          }
+#ifdef __linux__
+          struct epoll_event  ev;
+          ev.events = EPOLLIN;
+          ev.data.fd = r.fd;
+          epoll_ctl(epfd, EPOLL_CTL_ADD, r.fd, &ev);
+#endif
+          running.push_back(r);
+        }
+        if (running.empty()) {
+          continue;
+        }
+        
+        //  Wait no longer than the nearest deadline.
+        int   waitMs = -1;
+        auto  now = Clock::now();
+        for (const auto & r : running) {
+          if (r.hasDeadline) {
+            auto  ms = chrono::ceil<chrono::milliseconds>(r.deadline - now);
+            int   left = max((int)ms.count(), 0);
+            waitMs = ((waitMs < 0) ? left : min(waitMs, left));
+          }
+        }
+        vector<int>  ready;
+#ifdef __linux__
+        struct epoll_event  evs[32];
+        int  n = epoll_wait(epfd, evs, 32, waitMs);
+        for (int i = 0; i < n; ++i) {
+          ready.push_back(evs[i].data.fd);
+        }
+#else
+        vector<struct pollfd>  pfds;
+        for (const auto & r : running) {
+          pfds.push_back({r.fd, POLLIN, 0});
+        }
+        int  n = poll(pfds.data(), pfds.size(), waitMs);
+        for (int i = 0; (n > 0) && (i < (int)pfds.size()); ++i) {
+          if (pfds[i].revents) {
+            ready.push_back(pfds[i].fd);
+          }
+        }
+#endif
+        if ((n < 0) && (errno != EINTR)) {
+          //  Shouldn't happen; don't spin.  Kill what's left.
+          for (auto & r : running) {
+            results[r.idx].timedOut = true;
+            r.hasDeadline = true;
+            r.deadline = Clock::now();
+          }
+        }
+
+        now = Clock::now();
+        auto  done = [&] (Running & r)
+        {
+          Result  & result = results[r.idx];
+          bool      finished = false;
+          if (find(ready.begin(), ready.end(), r.fd) != ready.end()) {
+            finished = Drain(r.fd, result.output);
+          }
+          if ((! finished) && r.hasDeadline && (now >= r.deadline)) {
+            result.timedOut = true;
+            finished = true;
+          }
+          if (finished) {
+            //  close() takes the fd out of the epoll set.
+            Finish(r, result);
+          }
+          return finished;
+        };
+        running.erase(remove_if(running.begin(), running.end(), done),
+                      running.end());
+      }
+#ifdef __linux__
+      close(epfd);
+#endif
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ProcessRunner::Run(const Command & command, Result & result) const
+    {
+      vector<Result>  results;
+      if (Run(vector<Command>(1, command), results)) {
+        result = move(results.front());
+        return (result.exited && (result.exitStatus == 0));
+      }
+      result = Result();
+      return false;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
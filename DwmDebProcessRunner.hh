@@ -0,0 +1,124 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebProcessRunner.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ProcessRunner class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBPROCESSRUNNER_HH_
+#define _DWMDEBPROCESSRUNNER_HH_
+
+#include <string>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  Runs external tools and collects their standard output.  Commands
+    //!  are started directly with posix_spawnp() (no shell, so arguments
+    //!  need no quoting) with stdin and stderr on /dev/null, and up to
+    //!  MaxRunning() of them are serviced at a time from one event loop
+    //!  (epoll on Linux, poll() elsewhere).
+    //!
+    //!  Nothing here changes the process's signal dispositions.  We only
+    //!  ever read from the pipes, so SIGPIPE can't be raised in this
+    //!  process by them; the children get default SIGPIPE handling and an
+    //!  empty signal mask no matter what we have.  Run() keeps all of its
+    //!  state on the stack, so any number of threads may call it at once.
+    //------------------------------------------------------------------------
+    class ProcessRunner
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  argv[0] is looked up in PATH.  A command still running after
+      //!  timeoutMs milliseconds is killed; 0 means no limit.
+      //----------------------------------------------------------------------
+      struct Command
+      {
+        std::vector<std::string>  argv;
+        int                       timeoutMs = 0;
+      };
+
+      //----------------------------------------------------------------------
+      //!  exited is true if the command was started and exited on its
+      //!  own, in which case exitStatus is its exit status.  output is
+      //!  whatever it wrote to stdout, even if it was killed.
+      //----------------------------------------------------------------------
+      struct Result
+      {
+        bool         exited = false;
+        bool         timedOut = false;
+        int          exitStatus = -1;
+        std::string  output;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Runs at most @c maxRunning commands at once; 0 means the number
+      //!  of online CPUs.
+      //----------------------------------------------------------------------
+      ProcessRunner(size_t maxRunning = 0);
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      size_t MaxRunning() const
+      { return _maxRunning; }
+      
+      //----------------------------------------------------------------------
+      //!  Runs all of @c commands and fills @c results, one per command
+      //!  in the same order.  Returns false only if the event loop can't
+      //!  be set up; check each result for the fate of its command.
+      //----------------------------------------------------------------------
+      bool Run(const std::vector<Command> & commands,
+               std::vector<Result> & results) const;
+
+      //----------------------------------------------------------------------
+      //!  Runs one command.  Returns true if it exited with status 0.
+      //----------------------------------------------------------------------
+      bool Run(const Command & command, Result & result) const;
+      
+    private:
+      size_t  _maxRunning;
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBPROCESSRUNNER_HH_
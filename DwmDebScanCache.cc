@@ -0,0 +1,360 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebScanCache.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ScanCache class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/stat.h>
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "DwmDebScanCache.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //  First line of every entry.  Bump the number whenever the meaning
+    //  of an entry changes; old entries are then treated as misses.
+    static const string  k_entryMagic("mkdebcontrol scan cache 4");
+
+    //  Touched by Evict(); its modification time is when the directory
+    //  was last swept.
+    static const string  k_evictStamp("evict-stamp");
+    static constexpr time_t  k_day = 24 * 60 * 60;
+    
+    //------------------------------------------------------------------------
+    //!  64-bit FNV-1a of the contents of the file open on @c fd.
+    //------------------------------------------------------------------------
+    static bool HashFile(int fd, uint64_t & hash)
+    {
+      hash = 0xcbf29ce484222325ULL;
+      uint8_t  buf[65536];
+      ssize_t  len;
+      while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < len; ++i) {
+          hash ^= buf[i];
+          hash *= 0x100000001b3ULL;
+        }
+      }
+      return (len == 0);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ScanCache::ScanCache()
+        : _dir(), _useContentHash(false), _maxAgeDays(30), _hits(0),
+          _misses(0), _tmpSeq(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ScanCache::Open(const string & dir, bool useContentHash,
+                         unsigned int maxAgeDays)
+    {
+      bool  rc = false;
+      error_code  ec;
+      filesystem::create_directories(dir, ec);
+      if (filesystem::is_directory(dir, ec)) {
+        _dir = dir;
+        _useContentHash = useContentHash;
+        _maxAgeDays = maxAgeDays;
+        rc = true;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ScanCache::GetKey(const string & path, Key & key) const
+    {
+      bool  rc = false;
+      int   fd = open(path.c_str(), O_RDONLY);
+      if (fd >= 0) {
+        struct stat  st;
+        if (fstat(fd, &st) == 0) {
+          key.dev = st.st_dev;
+          key.ino = st.st_ino;
+          key.size = st.st_size;
+#ifdef __APPLE__
+          key.mtimeNs = (st.st_mtimespec.tv_sec * 1000000000ULL)
+            + st.st_mtimespec.tv_nsec;
+#else
+          key.mtimeNs = (st.st_mtim.tv_sec * 1000000000ULL)
+            + st.st_mtim.tv_nsec;
+#endif
+          key.hash = 0;
+          rc = _useContentHash ? HashFile(fd, key.hash) : true;
+        }
+        close(fd);
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ScanCache::Get(const Key & key, Entry & entry, bool needSymbols)
+    {
+      bool      rc = false;
+      string    entryPath = EntryPath(key);
+      ifstream  is(entryPath);
+      if (is) {
+        string  line;
+        if (getline(is, line) && (line == k_entryMagic)
+            && getline(is, line) && (line.compare(0, 5, "hash ") == 0)) {
+          char  hashstr[17];
+          snprintf(hashstr, sizeof(hashstr), "%016" PRIx64, key.hash);
+          if ((! _useContentHash) || (line.substr(5) == hashstr)) {
+            entry = Entry();
+            while (getline(is, line)) {
+              if (line.compare(0, 7, "needed ") == 0) {
+                entry.needed.push_back(line.substr(7));
+              }
+              else if (line.compare(0, 7, "soname ") == 0) {
+                entry.soname = line.substr(7);
+              }
+              else if (line.compare(0, 6, "rpath ") == 0) {
+                entry.rpath = line.substr(6);
+              }
+              else if (line.compare(0, 8, "runpath ") == 0) {
+                entry.runpath = line.substr(8);
+              }
+              else if (line.compare(0, 5, "arch ") == 0) {
+                entry.arch = line.substr(5);
+              }
+              else if (line.compare(0, 7, "symbol ") == 0) {
+                istringstream  ls(line.substr(7));
+                Entry::Symbol  sym;
+                if (ls >> sym.name >> sym.version >> sym.library) {
+                  if (sym.version == "-")  { sym.version.clear(); }
+                  if (sym.library == "-")  { sym.library.clear(); }
+                  entry.symbols.push_back(sym);
+                }
+              }
+              else if (line == "symbols") {
+                entry.haveSymbols = true;
+              }
+              else if (line == "end") {
+                break;
+              }
+            }
+            //  A missing 'end' means a truncated entry.
+            rc = (line == "end") && (entry.haveSymbols || (! needSymbols));
+          }
+        }
+      }
+      if (rc) {
+        ++_hits;
+        if (_maxAgeDays) {
+          Refresh(entryPath, time(nullptr) - k_day);
+        }
+      }
+      else {
+        ++_misses;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ScanCache::Put(const Key & key, const Entry & entry)
+    {
+      bool    rc = false;
+      string  entryPath = EntryPath(key);
+      string  tmpPath = entryPath + ".tmp." + to_string(getpid()) + '.'
+        + to_string(_tmpSeq++);
+      {
+        ofstream  os(tmpPath);
+        if (os) {
+          os << k_entryMagic << '\n';
+          if (_useContentHash) {
+            char  hashstr[17];
+            snprintf(hashstr, sizeof(hashstr), "%016" PRIx64, key.hash);
+            os << "hash " << hashstr << '\n';
+          }
+          else {
+            os << "hash -\n";
+          }
+          for (const auto & n : entry.needed) {
+            os << "needed " << n << '\n';
+          }
+          if (! entry.soname.empty()) {
+            os << "soname " << entry.soname << '\n';
+          }
+          if (! entry.rpath.empty()) {
+            os << "rpath " << entry.rpath << '\n';
+          }
+          if (! entry.runpath.empty()) {
+            os << "runpath " << entry.runpath << '\n';
+          }
+          if (! entry.arch.empty()) {
+            os << "arch " << entry.arch << '\n';
+          }
+          if (entry.haveSymbols) {
+            os << "symbols\n";
+            for (const auto & sym : entry.symbols) {
+              os << "symbol " << sym.name << ' '
+                 << (sym.version.empty() ? "-" : sym.version) << ' '
+                 << (sym.library.empty() ? "-" : sym.library) << '\n';
+            }
+          }
+          os << "end\n";
+          rc = os.good();
+        }
+      }
+      if (rc) {
+        rc = (rename(tmpPath.c_str(), entryPath.c_str()) == 0);
+      }
+      if (! rc) {
+        unlink(tmpPath.c_str());
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    uint64_t ScanCache::Evict()
+    {
+      uint64_t  removed = 0;
+      if (_dir.empty() || (_maxAgeDays == 0)) {
+        return removed;
+      }
+      time_t  now = time(nullptr);
+      string  stampPath = _dir + '/' + k_evictStamp;
+      int     fd = open(stampPath.c_str(), O_WRONLY|O_CREAT|O_EXCL, 0644);
+      if (fd >= 0) {
+        //  First sweep of this directory.
+        close(fd);
+      }
+      else if (! Refresh(stampPath, now - k_day)) {
+        return removed;
+      }
+      DIR  *dir = opendir(_dir.c_str());
+      if (! dir) {
+        return removed;
+      }
+      time_t  cutoff = now - ((time_t)_maxAgeDays * k_day);
+      while (struct dirent *de = readdir(dir)) {
+        string       name(de->d_name);
+        struct stat  st;
+        if (IsEntryName(name)
+            && (fstatat(dirfd(dir), de->d_name, &st,
+                        AT_SYMLINK_NOFOLLOW) == 0)
+            && S_ISREG(st.st_mode) && (st.st_mtime < cutoff)
+            && (unlinkat(dirfd(dir), de->d_name, 0) == 0)) {
+          ++removed;
+        }
+      }
+      closedir(dir);
+      return removed;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Entry names are four hex numbers joined by '-' (see EntryPath()),
+    //!  possibly followed by Put()'s '.tmp.' suffix.
+    //------------------------------------------------------------------------
+    bool ScanCache::IsEntryName(const string & name)
+    {
+      size_t  end = name.find(".tmp.");
+      if (end == string::npos) {
+        end = name.size();
+      }
+      int   dashes = 0;
+      bool  digit = false;
+      for (size_t i = 0; i < end; ++i) {
+        if (name[i] == '-') {
+          if (! digit) {
+            return false;
+          }
+          ++dashes;
+          digit = false;
+        }
+        else if (isxdigit((unsigned char)name[i])) {
+          digit = true;
+        }
+        else {
+          return false;
+        }
+      }
+      return (digit && (dashes == 3));
+    }
+
+    //------------------------------------------------------------------------
+    //!  Sets the modification time of @c path to now if it's older than
+    //!  @c olderThan.  Returns true if it did.
+    //------------------------------------------------------------------------
+    bool ScanCache::Refresh(const string & path, time_t olderThan)
+    {
+      struct stat  st;
+      return ((stat(path.c_str(), &st) == 0) && (st.st_mtime < olderThan)
+              && (utimensat(AT_FDCWD, path.c_str(), nullptr, 0) == 0));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string ScanCache::EntryPath(const Key & key) const
+    {
+      char  name[80];
+      snprintf(name, sizeof(name),
+               "%" PRIx64 "-%" PRIx64 "-%" PRIx64 "-%" PRIx64,
+               key.dev, key.ino, key.size, key.mtimeNs);
+      return _dir + '/' + name;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
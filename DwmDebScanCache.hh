@@ -0,0 +1,195 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebScanCache.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ScanCache class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBSCANCACHE_HH_
+#define _DWMDEBSCANCACHE_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  A persistent cache of per-file scan results, so that files which
+    //!  haven't changed since a previous run don't need to be read again.
+    //!
+    //!  Entries live in a directory, one file per entry, named from the
+    //!  file's device, inode, size and modification time.  An entry is
+    //!  written to a temporary file and then renamed into place, so any
+    //!  number of mkdebcontrol processes may share a cache directory
+    //!  without locking.  Stale entries are never read again since their
+    //!  names no longer match anything; they may be removed at any time.
+    //!  Evict() removes entries that haven't been used for a while.  An
+    //!  entry's modification time is refreshed (at most once a day) when
+    //!  it's used, since atime is often not maintained.
+    //!
+    //!  Optionally, a hash of the file's contents is stored in each entry
+    //!  and verified on lookup.  This guards against tools that rewrite
+    //!  a file and then restore its modification time, at the cost of
+    //!  reading every file.
+    //------------------------------------------------------------------------
+    class ScanCache
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Identifies one version of one file.
+      //----------------------------------------------------------------------
+      struct Key
+      {
+        uint64_t  dev;
+        uint64_t  ino;
+        uint64_t  size;
+        uint64_t  mtimeNs;
+        uint64_t  hash;
+      };
+
+      //----------------------------------------------------------------------
+      //!  What we know about one file.  @c soname, @c rpath and
+      //!  @c runpath are empty if the file has no such entry, and @c arch
+      //!  (the Debian architecture) is empty if it's unknown.  @c symbols
+      //!  holds the undefined dynamic symbols, and is only filled in if
+      //!  @c haveSymbols is true; see Dwm::Deb::ElfFile::SymbolRef.
+      //----------------------------------------------------------------------
+      struct Entry
+      {
+        struct Symbol
+        {
+          std::string  name;
+          std::string  version;
+          std::string  library;
+        };
+        
+        Entry()
+            : needed(), soname(), rpath(), runpath(), arch(),
+              haveSymbols(false), symbols()
+        {}
+        
+        std::vector<std::string>  needed;
+        std::string               soname;
+        std::string               rpath;
+        std::string               runpath;
+        std::string               arch;
+        bool                      haveSymbols;
+        std::vector<Symbol>       symbols;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ScanCache();
+
+      //----------------------------------------------------------------------
+      //!  Uses @c dir as the cache directory, creating it if necessary.
+      //!  If @c useContentHash is true, entries are only used if the
+      //!  file's contents still hash to the stored value.  Entries not
+      //!  used for @c maxAgeDays days are removed by Evict(); 0 keeps
+      //!  them forever.  Returns false if the directory can't be created.
+      //----------------------------------------------------------------------
+      bool Open(const std::string & dir, bool useContentHash,
+                unsigned int maxAgeDays = 30);
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      bool IsOpen() const
+      { return (! _dir.empty()); }
+      
+      //----------------------------------------------------------------------
+      //!  Fills @c key for the file at @c path.  Returns false if the
+      //!  file can't be stat'ed (or read, when using content hashes).
+      //----------------------------------------------------------------------
+      bool GetKey(const std::string & path, Key & key) const;
+      
+      //----------------------------------------------------------------------
+      //!  Looks up the entry for @c key.  On a hit, fills @c entry and
+      //!  returns true.  If @c needSymbols is true, an entry stored
+      //!  without symbols counts as a miss.
+      //----------------------------------------------------------------------
+      bool Get(const Key & key, Entry & entry, bool needSymbols = false);
+
+      //----------------------------------------------------------------------
+      //!  Stores @c entry as the entry for @c key.
+      //----------------------------------------------------------------------
+      bool Put(const Key & key, const Entry & entry);
+
+      //----------------------------------------------------------------------
+      //!  Removes entries (and leftover temporary files) that haven't
+      //!  been used for the maximum age given to Open().  Since this
+      //!  reads the whole directory, it only does so if no process
+      //!  sharing the directory has done it in the last day.  Other files
+      //!  in the directory are left alone.  Returns the number of files
+      //!  removed.
+      //----------------------------------------------------------------------
+      uint64_t Evict();
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      uint64_t Hits() const    { return _hits; }
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      uint64_t Misses() const  { return _misses; }
+      
+    private:
+      std::string            _dir;
+      bool                   _useContentHash;
+      unsigned int           _maxAgeDays;
+      std::atomic<uint64_t>  _hits;
+      std::atomic<uint64_t>  _misses;
+      std::atomic<uint64_t>  _tmpSeq;
+
+      std::string EntryPath(const Key & key) const;
+      static bool IsEntryName(const std::string & name);
+      static bool Refresh(const std::string & path, time_t olderThan);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBSCANCACHE_HH_
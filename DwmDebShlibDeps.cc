@@ -0,0 +1,366 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebShlibDeps.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ShlibDeps class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "DwmDebShlibDeps.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static string Trim(const string & s)
+    {
+      size_t  b = s.find_first_not_of(" \t");
+      if (b == string::npos) {
+        return string();
+      }
+      return s.substr(b, s.find_last_not_of(" \t") + 1 - b);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Parses the first alternative of a dependency such as
+    //!  'zlib1g (>= 1:1.2.3.3.dfsg-1)' into @c dep.
+    //------------------------------------------------------------------------
+    static bool ParseDepend(const string & s, PkgDepend & dep)
+    {
+      string  first = s.substr(0, s.find_first_of(",|"));
+      size_t  lp = first.find('(');
+      string  pkg = Trim(first.substr(0, lp));
+      if (pkg.empty() || (pkg.find_first_of(" \t") != string::npos)) {
+        return false;
+      }
+      dep = PkgDepend(pkg);
+      if (lp != string::npos) {
+        size_t  rp = first.find(')', lp);
+        if (rp == string::npos) {
+          return false;
+        }
+        string  constraint = first.substr(lp + 1, rp - lp - 1);
+        size_t  opEnd = constraint.find_first_not_of("<>= \t");
+        string  op = constraint.substr(0, opEnd);
+        op.erase(remove_if(op.begin(), op.end(),
+                           [] (unsigned char c) { return isspace(c); }),
+                 op.end());
+        PkgVersion  version;
+        if (op.empty() || (opEnd == string::npos)
+            || (! version.FromString(Trim(constraint.substr(opEnd))))) {
+          return false;
+        }
+        dep.Operator(op);
+        dep.Version(version);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Returns true if a symbol tagged 'arch=@c archs' applies to
+    //!  @c arch.  @c archs is a space-separated list of architectures,
+    //!  all negated ('!arch') or none.  Wildcards are OS-CPU patterns
+    //!  such as 'any-amd64' and 'linux-any'; all of our architectures are
+    //!  Linux ones.  An empty @c arch (unknown) matches everything.
+    //------------------------------------------------------------------------
+    static bool ArchMatches(const string & archs, const string & arch)
+    {
+      if (arch.empty()) {
+        return true;
+      }
+      istringstream  is(archs);
+      string         a;
+      bool           negated = false;
+      while (is >> a) {
+        negated = (a[0] == '!');
+        if (negated) {
+          a.erase(0, 1);
+        }
+        bool  match = ((a == arch) || (a == "any") || (a == "linux-any")
+                       || (a == ("any-" + arch)));
+        if (match) {
+          return (! negated);
+        }
+      }
+      return negated;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShlibDeps::ShlibDeps(const string & infoDir)
+        : _infoDir(infoDir), _haveInfoFiles(false), _symbolsFiles(),
+          _shlibsFiles()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShlibDeps::GetDepend(const string & pkg, const string & soname,
+                              const string & arch,
+                              const set<string> & symbols, PkgDepend & dep)
+    {
+      if (! _haveInfoFiles) {
+        FindInfoFiles();
+      }
+      auto  it = _symbolsFiles.find(pkg);
+      if (it != _symbolsFiles.end()) {
+        for (const auto & path : it->second) {
+          if (FromSymbolsFile(path, soname, arch, symbols, dep)) {
+            return true;
+          }
+        }
+      }
+      it = _shlibsFiles.find(pkg);
+      if (it != _shlibsFiles.end()) {
+        for (const auto & path : it->second) {
+          if (FromShlibsFile(path, soname, dep)) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Info files are named 'package.ext' or, for multi-arch packages,
+    //!  'package:arch.ext'.
+    //------------------------------------------------------------------------
+    void ShlibDeps::FindInfoFiles()
+    {
+      error_code  ec;
+      for (const auto & entry : filesystem::directory_iterator(_infoDir, ec)) {
+        string  name = entry.path().filename().string();
+        string  ext = entry.path().extension().string();
+        string  pkg = name.substr(0, min(name.find(':'),
+                                         name.size() - ext.size()));
+        if (ext == ".symbols") {
+          _symbolsFiles[pkg].push_back(entry.path().string());
+        }
+        else if (ext == ".shlibs") {
+          _shlibsFiles[pkg].push_back(entry.path().string());
+        }
+      }
+      for (auto & sf : _symbolsFiles) {
+        sort(sf.second.begin(), sf.second.end());
+      }
+      for (auto & sf : _shlibsFiles) {
+        sort(sf.second.begin(), sf.second.end());
+      }
+      _haveInfoFiles = true;
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  A symbols file has a header line for each library, 'soname
+    //!  template', followed by one line per symbol, ' name@version
+    //!  minver [id]'.  The dependency is the template with #MINVER#
+    //!  replaced by the highest minver of the symbols we use, or by the
+    //!  lowest minver in the section if we don't use any of them (as
+    //!  dpkg-shlibdeps(1) does).  A minver of 0 means the symbol has
+    //!  always been there; if that's what we end up with, the dependency
+    //!  is unversioned.  A '(symver)' line names a version node, and
+    //!  matches if we use any symbol of that version.  '(arch=...)' lines
+    //!  only count on the listed architectures.  Symbols with c++, regex
+    //!  or wildcard tags can't be matched by name and are skipped.
+    //------------------------------------------------------------------------
+    bool ShlibDeps::FromSymbolsFile(const string & path, const string & soname,
+                                    const string & arch,
+                                    const set<string> & symbols,
+                                    PkgDepend & dep)
+    {
+      ifstream  is(path);
+      if (! is) {
+        return false;
+      }
+      set<string>  versions;
+      for (const auto & sym : symbols) {
+        size_t  at = sym.rfind('@');
+        if (at != string::npos) {
+          versions.insert(sym.substr(at + 1));
+        }
+      }
+      bool        found = false;
+      string      tmpl;
+      bool        haveLowest = false, haveUsed = false;
+      PkgVersion  lowest, used;
+      string      line;
+      while (getline(is, line)) {
+        if (line.empty() || (line[0] == '#') || (line[0] == '|')
+            || (line[0] == '*')) {
+          continue;
+        }
+        if ((line[0] != ' ') && (line[0] != '\t')) {
+          if (found) {
+            break;
+          }
+          size_t  sp = line.find_first_of(" \t");
+          if ((sp != string::npos) && (line.compare(0, sp, soname) == 0)) {
+            found = true;
+            tmpl = line.substr(sp + 1);
+          }
+          continue;
+        }
+        if (! found) {
+          continue;
+        }
+        string  sym = Trim(line);
+        bool    symver = false;
+        if (sym[0] == '(') {
+          size_t  rp = sym.find(')');
+          if (rp == string::npos) {
+            continue;
+          }
+          istringstream  ts(sym.substr(1, rp - 1));
+          string         tag;
+          bool           skip = false;
+          while (getline(ts, tag, '|')) {
+            tag = Trim(tag);
+            if ((tag == "c++") || (tag == "regex") || (tag == "wildcard")) {
+              skip = true;
+            }
+            else if (tag == "symver") {
+              symver = true;
+            }
+            else if ((tag.compare(0, 5, "arch=") == 0)
+                     && (! ArchMatches(tag.substr(5), arch))) {
+              skip = true;
+            }
+          }
+          if (skip) {
+            continue;
+          }
+          sym = sym.substr(rp + 1);
+        }
+        istringstream  ls(sym);
+        string         minver;
+        PkgVersion     v;
+        if ((! (ls >> sym >> minver)) || (! v.FromString(minver))) {
+          continue;
+        }
+        if ((! haveLowest) || (v < lowest)) {
+          lowest = v;
+          haveLowest = true;
+        }
+        bool  isUsed = (symver ? (versions.count(sym) > 0)
+                        : (symbols.count(sym) > 0));
+        if (isUsed && ((! haveUsed) || (used < v))) {
+          used = v;
+          haveUsed = true;
+        }
+      }
+      if (! found) {
+        return false;
+      }
+      size_t  mv = tmpl.find("#MINVER#");
+      if (mv == string::npos) {
+        return ParseDepend(tmpl, dep);
+      }
+      if (! ParseDepend(tmpl.substr(0, mv) + tmpl.substr(mv + 8), dep)) {
+        return false;
+      }
+      if (haveUsed || haveLowest) {
+        const PkgVersion  & minver = (haveUsed ? used : lowest);
+        if (minver != PkgVersion("0")) {
+          dep.Operator(">=");
+          dep.Version(minver);
+        }
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  A shlibs file has one line per library: '[type:] library
+    //!  soversion dependencies', where 'libfoo.so.1' is library 'libfoo'
+    //!  with soversion '1' and 'libfoo-1.2.so' is library 'libfoo' with
+    //!  soversion '1.2'.  Lines with a type (e.g. 'udeb:') are for other
+    //!  kinds of packages.
+    //------------------------------------------------------------------------
+    bool ShlibDeps::FromShlibsFile(const string & path, const string & soname,
+                                   PkgDepend & dep)
+    {
+      string  library, soversion;
+      size_t  so = soname.find(".so.");
+      if (so != string::npos) {
+        library = soname.substr(0, so);
+        soversion = soname.substr(so + 4);
+      }
+      else if ((soname.size() > 3)
+               && (soname.compare(soname.size() - 3, 3, ".so") == 0)) {
+        string  base = soname.substr(0, soname.size() - 3);
+        size_t  dash = base.rfind('-');
+        if ((dash == string::npos) || ((dash + 1) >= base.size())
+            || (! isdigit((unsigned char)base[dash + 1]))) {
+          return false;
+        }
+        library = base.substr(0, dash);
+        soversion = base.substr(dash + 1);
+      }
+      else {
+        return false;
+      }
+      
+      ifstream  is(path);
+      string    line;
+      while (getline(is, line)) {
+        istringstream  ls(line);
+        string         lib, vers;
+        if ((! (ls >> lib)) || (lib[0] == '#') || (lib.back() == ':')) {
+          continue;
+        }
+        if ((ls >> vers) && (lib == library) && (vers == soversion)) {
+          string  deps;
+          getline(ls, deps);
+          return ParseDepend(deps, dep);
+        }
+      }
+      return false;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
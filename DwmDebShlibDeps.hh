@@ -0,0 +1,104 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebShlibDeps.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::ShlibDeps class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBSHLIBDEPS_HH_
+#define _DWMDEBSHLIBDEPS_HH_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "DwmDebPkgDepend.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  Computes minimal shared library dependencies from the symbols(5)
+    //!  and shlibs files installed in the dpkg info directory, the way
+    //!  dpkg-shlibdeps(1) does.  With a symbols file, the dependency is
+    //!  on the highest minimal version of the symbols we actually use.
+    //!  Without one, we fall back to the library's shlibs entry.
+    //------------------------------------------------------------------------
+    class ShlibDeps
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ShlibDeps(const std::string & infoDir = "/var/lib/dpkg/info");
+
+      //----------------------------------------------------------------------
+      //!  Fills @c dep with the dependency needed for the shared library
+      //!  @c soname from package @c pkg, given the @c symbols we use from
+      //!  it on Debian architecture @c arch (empty if unknown).  Symbols
+      //!  are of the form 'name@version', with 'Base' as the version of
+      //!  unversioned symbols, as in symbols files.  Returns false if
+      //!  @c pkg has no symbols or shlibs information for @c soname.
+      //----------------------------------------------------------------------
+      bool GetDepend(const std::string & pkg, const std::string & soname,
+                     const std::string & arch,
+                     const std::set<std::string> & symbols, PkgDepend & dep);
+      
+    private:
+      std::string                                      _infoDir;
+      bool                                             _haveInfoFiles;
+      std::map<std::string,std::vector<std::string>>  _symbolsFiles;
+      std::map<std::string,std::vector<std::string>>  _shlibsFiles;
+
+      void FindInfoFiles();
+      static bool FromSymbolsFile(const std::string & path,
+                                  const std::string & soname,
+                                  const std::string & arch,
+                                  const std::set<std::string> & symbols,
+                                  PkgDepend & dep);
+      static bool FromShlibsFile(const std::string & path,
+                                 const std::string & soname,
+                                 PkgDepend & dep);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBSHLIBDEPS_HH_
@@ -0,0 +1,250 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebSonameResolver.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::SonameResolver class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "DwmDebSonameResolver.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //  Layout of ld.so.cache, from glibc's sysdeps/generic/dl-cache.h.
+    //  The old format is a 16-byte header followed by 12-byte entries.
+    //  The new format is a 48-byte header followed by 24-byte entries,
+    //  and may follow an old-format cache (aligned to 8 bytes).  All
+    //  values are in host byte order.
+    static const char    k_oldMagic[] = "ld.so-1.7.0";
+    static const char    k_newMagic[] = "glibc-ld.so.cache1.1";
+    static const size_t  k_oldHeaderSize = 16;
+    static const size_t  k_oldEntrySize = 12;
+    static const size_t  k_newHeaderSize = 48;
+    static const size_t  k_newEntrySize = 24;
+    static const uint8_t k_endianLittle = 2;
+    static const uint8_t k_endianBig = 3;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static uint32_t Read32(const uint8_t *p)
+    {
+      uint32_t  rc;
+      memcpy(&rc, p, sizeof(rc));
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SonameResolver::SonameResolver(const string & sysroot)
+        : _data(nullptr), _size(0), _cache(), _searchDirs(), _sysroot(sysroot)
+    {
+      while ((! _sysroot.empty()) && (_sysroot.back() == '/')) {
+        _sysroot.pop_back();
+      }
+      string  cachePath = _sysroot + "/etc/ld.so.cache";
+      int     fd = open(cachePath.c_str(), O_RDONLY);
+      if (fd >= 0) {
+        struct stat  st;
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+          void  *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE,
+                             fd, 0);
+          if (addr != MAP_FAILED) {
+            _data = (const uint8_t *)addr;
+            _size = st.st_size;
+            if (! ParseCache()) {
+              _cache.clear();
+            }
+          }
+        }
+        close(fd);
+      }
+      FindSearchDirs();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SonameResolver::~SonameResolver()
+    {
+      if (_data) {
+        munmap((void *)_data, _size);
+      }
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SonameResolver::Resolve(const string & soname,
+                                 vector<string> & paths) const
+    {
+      paths.clear();
+      vector<string>  found;
+      auto  it = _cache.find(soname);
+      if (it != _cache.end()) {
+        for (const auto & path : it->second) {
+          found.emplace_back(path);
+        }
+      }
+      for (const auto & dir : _searchDirs) {
+        string  path = dir + '/' + soname;
+        if (access((_sysroot + path).c_str(), F_OK) == 0) {
+          found.push_back(path);
+        }
+      }
+      for (const auto & path : found) {
+        string  alias;
+        if (path.compare(0, 5, "/usr/") == 0) {
+          alias = path.substr(4);
+        }
+        else {
+          alias = "/usr" + path;
+        }
+        for (const auto & p : { path, alias }) {
+          if (find(paths.begin(), paths.end(), p) == paths.end()) {
+            paths.push_back(p);
+          }
+        }
+      }
+      return (! paths.empty());
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SonameResolver::ParseCache()
+    {
+      size_t  hdr = 0;
+      if ((_size >= k_oldHeaderSize)
+          && (memcmp(_data, k_oldMagic, sizeof(k_oldMagic) - 1) == 0)) {
+        uint64_t  nlibs = Read32(_data + 12);
+        hdr = k_oldHeaderSize + (nlibs * k_oldEntrySize);
+        hdr = (hdr + 7) & ~(size_t)7;
+      }
+      if ((hdr > _size) || ((_size - hdr) < k_newHeaderSize)
+          || (memcmp(_data + hdr, k_newMagic, sizeof(k_newMagic) - 1) != 0)) {
+        return false;
+      }
+      const uint8_t  *base = _data + hdr;
+      size_t          len = _size - hdr;
+      uint64_t        nlibs = Read32(base + 20);
+      uint8_t         endian = base[28];
+      uint16_t        one = 1;
+      uint8_t         hostEndian = (*(const uint8_t *)&one)
+                                   ? k_endianLittle : k_endianBig;
+      if (((endian == k_endianLittle) || (endian == k_endianBig))
+          && (endian != hostEndian)) {
+        return false;
+      }
+      if (nlibs > ((len - k_newHeaderSize) / k_newEntrySize)) {
+        return false;
+      }
+      //  String offsets are relative to the new-format header.
+      auto  stringAt = [&] (uint32_t off, string_view & s)
+      {
+        if (off >= len) {
+          return false;
+        }
+        const void  *nul = memchr(base + off, '\0', len - off);
+        if (! nul) {
+          return false;
+        }
+        s = string_view((const char *)base + off,
+                        (const uint8_t *)nul - (base + off));
+        return true;
+      };
+      _cache.reserve(nlibs);
+      for (uint64_t i = 0; i < nlibs; ++i) {
+        const uint8_t  *entry = base + k_newHeaderSize + (i * k_newEntrySize);
+        string_view     key, value;
+        if ((! stringAt(Read32(entry + 4), key))
+            || (! stringAt(Read32(entry + 8), value))) {
+          return false;
+        }
+        _cache[key].push_back(value);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The dynamic linker's built-in directories: the multiarch
+    //!  directories (e.g. /usr/lib/x86_64-linux-gnu) followed by the
+    //!  traditional ones.
+    //------------------------------------------------------------------------
+    void SonameResolver::FindSearchDirs()
+    {
+      error_code  ec;
+      for (const string dir : { "/lib", "/usr/lib" }) {
+        vector<string>  multiarch;
+        for (const auto & entry
+               : filesystem::directory_iterator(_sysroot + dir, ec)) {
+          string  name = entry.path().filename().string();
+          if ((name.find("-linux-") != string::npos)
+              && entry.is_directory(ec)) {
+            multiarch.push_back(dir + '/' + name);
+          }
+        }
+        sort(multiarch.begin(), multiarch.end());
+        _searchDirs.insert(_searchDirs.end(), multiarch.begin(),
+                           multiarch.end());
+      }
+      for (const string dir : { "/lib", "/usr/lib", "/lib64", "/usr/lib64" }) {
+        if (filesystem::is_directory(_sysroot + dir, ec)) {
+          _searchDirs.push_back(dir);
+        }
+      }
+      return;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
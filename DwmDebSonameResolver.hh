@@ -0,0 +1,119 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebSonameResolver.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::SonameResolver class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBSONAMERESOLVER_HH_
+#define _DWMDEBSONAMERESOLVER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  Maps sonames to the paths the dynamic linker would load them
+    //!  from, so packages can be looked up by exact path instead of by
+    //!  pattern.  /etc/ld.so.cache (glibc's 'glibc-ld.so.cache1.1'
+    //!  format, alone or after an old-format cache) is mapped and indexed
+    //!  once; sonames it doesn't know are looked for in the default
+    //!  library directories.
+    //!
+    //!  With a sysroot, the cache and the directories are those under the
+    //!  sysroot, but paths are still returned as the target sees them
+    //!  (without the sysroot), since that's how its dpkg database knows
+    //!  them.
+    //------------------------------------------------------------------------
+    class SonameResolver
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Maps and indexes @c sysroot/etc/ld.so.cache.  A missing or
+      //!  unreadable cache isn't an error; only the default directories
+      //!  are searched then.  An empty @c sysroot is the host's root.
+      //----------------------------------------------------------------------
+      SonameResolver(const std::string & sysroot = "");
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      ~SonameResolver();
+
+      SonameResolver(const SonameResolver &) = delete;
+      SonameResolver & operator = (const SonameResolver &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Fills @c paths with the places @c soname may be found, best
+      //!  first: cache entries in cache order, then the default library
+      //!  directories.  On merged-/usr systems a file may be registered
+      //!  with dpkg under either /lib or /usr/lib, so both spellings are
+      //!  returned.  Returns false if @c soname wasn't found anywhere.
+      //----------------------------------------------------------------------
+      bool Resolve(const std::string & soname,
+                   std::vector<std::string> & paths) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of distinct sonames read from the cache.
+      //----------------------------------------------------------------------
+      size_t CacheEntries() const
+      { return _cache.size(); }
+      
+    private:
+      const uint8_t                                     *_data;
+      size_t                                             _size;
+      std::unordered_map<std::string_view,
+                         std::vector<std::string_view>>  _cache;
+      std::vector<std::string>                           _searchDirs;
+      std::string                                        _sysroot;
+
+      bool ParseCache();
+      void FindSearchDirs();
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBSONAMERESOLVER_HH_
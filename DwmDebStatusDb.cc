@@ -0,0 +1,218 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebStatusDb.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::StatusDb class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <strings.h>
+}
+
+#include <cstring>
+#include <fstream>
+
+#include "DwmDebStatusDb.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  Field names are case-insensitive.
+    //------------------------------------------------------------------------
+    static bool IsField(string_view name, const char *field)
+    {
+      return ((name.size() == strlen(field))
+              && (strncasecmp(name.data(), field, name.size()) == 0));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static string_view Trim(string_view s)
+    {
+      size_t  start = s.find_first_not_of(" \t");
+      if (start == string_view::npos) {
+        return string_view();
+      }
+      size_t  end = s.find_last_not_of(" \t\r");
+      return s.substr(start, (end + 1) - start);
+    }
+
+    //------------------------------------------------------------------------
+    //!  Returns true if the last word of a Status: field ("want flag
+    //!  state") is a state in which dpkg considers the package installed.
+    //------------------------------------------------------------------------
+    static bool IsInstalled(string_view status)
+    {
+      size_t       sp = status.find_last_of(" \t");
+      string_view  state = ((sp == string_view::npos)
+                            ? status : status.substr(sp + 1));
+      return ((state == "installed") || (state == "triggers-pending")
+              || (state == "triggers-awaited"));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    StatusDb::StatusDb()
+        : _versions(), _archs(), _numInstalled(0), _loaded(false)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool StatusDb::Load(const string & statusPath)
+    {
+      _versions.clear();
+      _archs.clear();
+      _numInstalled = 0;
+      _loaded = false;
+
+      ifstream  is(statusPath, ios::binary);
+      if (! is) {
+        return false;
+      }
+      string  contents;
+      is.seekg(0, ios::end);
+      contents.resize(is.tellg());
+      is.seekg(0, ios::beg);
+      is.read(contents.data(), contents.size());
+      if (! is) {
+        return false;
+      }
+
+      string_view  pkg, arch, status, version;
+      string_view  s(contents);
+      while (! s.empty()) {
+        size_t       eol = s.find('\n');
+        string_view  line = s.substr(0, eol);
+        s.remove_prefix((eol == string_view::npos) ? s.size() : (eol + 1));
+        if (Trim(line).empty()) {
+          //  End of a stanza.
+          Add(pkg, arch, status, version);
+          pkg = arch = status = version = string_view();
+          continue;
+        }
+        if ((line[0] == ' ') || (line[0] == '\t')) {
+          continue;  // continuation of a multi-line field
+        }
+        size_t  colon = line.find(':');
+        if (colon == string_view::npos) {
+          continue;
+        }
+        string_view  name = line.substr(0, colon);
+        string_view  value = Trim(line.substr(colon + 1));
+        if (IsField(name, "Package")) {
+          pkg = value;
+        }
+        else if (IsField(name, "Architecture")) {
+          arch = value;
+        }
+        else if (IsField(name, "Status")) {
+          status = value;
+        }
+        else if (IsField(name, "Version")) {
+          version = value;
+        }
+      }
+      Add(pkg, arch, status, version);
+      _loaded = true;
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool StatusDb::InstalledVersion(string_view pkg,
+                                    PkgVersion & version) const
+    {
+      auto  it = _versions.find(string(pkg));
+      if (it != _versions.end()) {
+        version = it->second;
+        return true;
+      }
+      return false;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool StatusDb::Architecture(string_view pkg, string & arch) const
+    {
+      auto  it = _archs.find(string(pkg));
+      if (it != _archs.end()) {
+        arch = it->second;
+        return true;
+      }
+      return false;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void StatusDb::Add(string_view pkg, string_view arch,
+                       string_view status, string_view version)
+    {
+      if (pkg.empty() || version.empty() || (! IsInstalled(status))) {
+        return;
+      }
+      PkgVersion  pkgVersion;
+      if (! pkgVersion.FromString(version)) {
+        return;
+      }
+      ++_numInstalled;
+      if (! arch.empty()) {
+        string  qualified(pkg);
+        qualified += ':';
+        qualified += arch;
+        _versions[qualified] = pkgVersion;
+        _archs[string(pkg)] = arch;
+      }
+      auto  [it, added] = _versions.emplace(string(pkg), pkgVersion);
+      if ((! added) && (pkgVersion > it->second)) {
+        it->second = pkgVersion;
+      }
+      return;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,122 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebStatusDb.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::StatusDb class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBSTATUSDB_HH_
+#define _DWMDEBSTATUSDB_HH_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "DwmDebPkgVersion.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  The installed versions of packages, read in one pass from the
+    //!  dpkg status file.  Only packages whose Status: field says they're
+    //!  installed (including those with pending triggers) are kept, so
+    //!  packages that are removed but have config files left behind, or
+    //!  are half-installed, have no version here.
+    //!
+    //!  Each package can be looked up by name or by name:arch.  When a
+    //!  Multi-Arch: same package is installed for several architectures,
+    //!  a lookup by bare name returns the highest of their versions.
+    //------------------------------------------------------------------------
+    class StatusDb
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      StatusDb();
+
+      //----------------------------------------------------------------------
+      //!  Reads the status file at @c statusPath.  Returns false if it
+      //!  can't be read.
+      //----------------------------------------------------------------------
+      bool Load(const std::string & statusPath = "/var/lib/dpkg/status");
+
+      //----------------------------------------------------------------------
+      //!  Returns true if Load() succeeded.
+      //----------------------------------------------------------------------
+      bool IsLoaded() const
+      { return _loaded; }
+
+      //----------------------------------------------------------------------
+      //!  Sets @c version to the installed version of @c pkg, which may
+      //!  be a bare package name or name:arch.  Returns false if @c pkg
+      //!  is not installed.
+      //----------------------------------------------------------------------
+      bool InstalledVersion(std::string_view pkg, PkgVersion & version) const;
+
+      //----------------------------------------------------------------------
+      //!  Sets @c arch to the architecture of the installed package
+      //!  @c pkg (a bare name), which may be 'all'.  For a package
+      //!  installed for several architectures, it's any one of them.
+      //!  Returns false if @c pkg is not installed.
+      //----------------------------------------------------------------------
+      bool Architecture(std::string_view pkg, std::string & arch) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of installed packages (counting each
+      //!  architecture of a multiarch package).
+      //----------------------------------------------------------------------
+      size_t NumInstalled() const
+      { return _numInstalled; }
+      
+    private:
+      std::unordered_map<std::string,PkgVersion>  _versions;
+      std::unordered_map<std::string,std::string> _archs;
+      size_t                                      _numInstalled;
+      bool                                        _loaded;
+
+      void Add(std::string_view pkg, std::string_view arch,
+               std::string_view status, std::string_view version);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBSTATUSDB_HH_
@@ -0,0 +1,289 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebVersionCompare.hh
+//!  \author Daniel W. McRobb
+//!  \brief Debian version parsing and comparison functions
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBVERSIONCOMPARE_HH_
+#define _DWMDEBVERSIONCOMPARE_HH_
+
+#include <string>
+#include <string_view>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    namespace VersionCompare {
+
+      //----------------------------------------------------------------------
+      //!  Splits @c s as [epoch:]version[-release].  As in dpkg, the
+      //!  release follows the last '-', so the version may contain '-'.
+      //!  If there's no usable epoch or release (e.g. '1:' or '1.0-'),
+      //!  all of @c s is the version.  An epoch too big for an int is 0.
+      //!  Returns false if @c s is empty.
+      //----------------------------------------------------------------------
+      constexpr bool Split(std::string_view s, int & epoch,
+                           std::string_view & upstream,
+                           std::string_view & release)
+      {
+        //  A release can't be empty or span lines.
+        auto  isRelease = [] (std::string_view r)
+        { return ((! r.empty()) && (r.find_first_of("\n\r") == r.npos)); };
+
+        epoch = 0;
+        upstream = std::string_view();
+        release = std::string_view();
+        size_t     digits = 0;
+        long long  e = 0;
+        for ( ; (digits < s.size()) && (s[digits] >= '0')
+                && (s[digits] <= '9'); ++digits) {
+          if (e <= 0x7FFFFFFF) {
+            e = (e * 10) + (s[digits] - '0');
+          }
+        }
+        if (digits && (digits < s.size()) && (s[digits] == ':')) {
+          std::string_view  rest = s.substr(digits + 1);
+          size_t            hyphen = rest.rfind('-');
+          if ((hyphen != rest.npos) && hyphen
+              && isRelease(rest.substr(hyphen + 1))) {
+            epoch = ((e <= 0x7FFFFFFF) ? static_cast<int>(e) : 0);
+            upstream = rest.substr(0, hyphen);
+            release = rest.substr(hyphen + 1);
+            return true;
+          }
+          if ((hyphen == rest.npos) && (! rest.empty())) {
+            epoch = ((e <= 0x7FFFFFFF) ? static_cast<int>(e) : 0);
+            upstream = rest;
+            return true;
+          }
+        }
+        size_t  hyphen = s.rfind('-');
+        if ((hyphen != s.npos) && hyphen && isRelease(s.substr(hyphen + 1))) {
+          upstream = s.substr(0, hyphen);
+          release = s.substr(hyphen + 1);
+          return true;
+        }
+        upstream = s;
+        return (! s.empty());
+      }
+
+      //----------------------------------------------------------------------
+      //!  Sort weight of a non-digit character (or the end of the string,
+      //!  as 0) in a version: '~' sorts before everything, even the end,
+      //!  then letters, then everything else.  Deliberately not using
+      //!  <cctype>, whose answers depend on the locale.
+      //----------------------------------------------------------------------
+      constexpr int Order(int c)
+      {
+        if ((c >= '0') && (c <= '9')) {
+          return 0;
+        }
+        if (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z'))) {
+          return c;
+        }
+        if (c == '~') {
+          return -1;
+        }
+        return (c ? (c + 256) : 0);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Compares two upstream versions or two Debian revisions the way
+      //!  dpkg's verrevcmp() does: alternating runs of non-digits
+      //!  (compared character by character with Order()) and digits
+      //!  (compared numerically, of any length).  Returns less than,
+      //!  equal to or greater than 0 as @c a is less than, equal to or
+      //!  greater than @c b.  Doesn't allocate.
+      //----------------------------------------------------------------------
+      constexpr int VerRevCmp(std::string_view a, std::string_view b)
+      {
+        auto  isDigit = [] (int c) { return ((c >= '0') && (c <= '9')); };
+        size_t  i = 0, j = 0;
+        auto  ca = [&] { return (i < a.size()) ? (unsigned char)a[i] : 0; };
+        auto  cb = [&] { return (j < b.size()) ? (unsigned char)b[j] : 0; };
+        while ((i < a.size()) || (j < b.size())) {
+          int  firstDiff = 0;
+          while (((i < a.size()) && (! isDigit(ca())))
+                 || ((j < b.size()) && (! isDigit(cb())))) {
+            int  ac = Order(ca());
+            int  bc = Order(cb());
+            if (ac != bc) {
+              return (ac - bc);
+            }
+            ++i;
+            ++j;
+          }
+          while (ca() == '0') {
+            ++i;
+          }
+          while (cb() == '0') {
+            ++j;
+          }
+          while (isDigit(ca()) && isDigit(cb())) {
+            if (! firstDiff) {
+              firstDiff = ca() - cb();
+            }
+            ++i;
+            ++j;
+          }
+          if (isDigit(ca())) {
+            return 1;
+          }
+          if (isDigit(cb())) {
+            return -1;
+          }
+          if (firstDiff) {
+            return firstDiff;
+          }
+        }
+        return 0;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Compares two full versions: epoch numerically, then the upstream
+      //!  versions and then the revisions with VerRevCmp().
+      //----------------------------------------------------------------------
+      constexpr int Compare(int epochA, std::string_view upstreamA,
+                            std::string_view revisionA,
+                            int epochB, std::string_view upstreamB,
+                            std::string_view revisionB)
+      {
+        if (epochA != epochB) {
+          return ((epochA < epochB) ? -1 : 1);
+        }
+        int  rc = VerRevCmp(upstreamA, upstreamB);
+        return (rc ? rc : VerRevCmp(revisionA, revisionB));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Byte that stands for the non-digit character @c c in a sort key
+      //!  from AppendKey(): '~' is 1, the end of a run of non-digits is 2,
+      //!  then letters and then everything else, each in ASCII order, so
+      //!  the bytes sort the way Order() does.
+      //----------------------------------------------------------------------
+      constexpr unsigned char KeyByte(unsigned char c)
+      {
+        if (c == '~') {
+          return 1;
+        }
+        if ((c >= 'A') && (c <= 'Z')) {
+          return (3 + (c - 'A'));
+        }
+        if ((c >= 'a') && (c <= 'z')) {
+          return (29 + (c - 'a'));
+        }
+        //  Rank among the remaining characters, after the 52 letters.
+        unsigned int  rank = c;
+        rank -= ((c > '9') ? 10 : 0);
+        rank -= ((c > 'Z') ? 26 : 0);
+        rank -= ((c > 'z') ? 26 : 0);
+        rank -= ((c > '~') ? 1 : 0);
+        return (54 + rank);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Appends to @c key a sort key for the upstream version or Debian
+      //!  revision @c v, such that comparing two keys with memcmp() (or
+      //!  std::string::compare()) orders them as VerRevCmp() would.
+      //!
+      //!  Each run of non-digits is encoded with KeyByte() and ended with
+      //!  a 2.  Each run of digits is encoded as the number of digits
+      //!  left after stripping leading zeros (one byte, or 0xFF and four
+      //!  big-endian bytes for 255 or more) followed by those digits.
+      //!  Trailing empty runs and zeros are dropped since they compare
+      //!  equal to the end of a version, and the end is encoded as 2 0 2
+      //!  so it sorts after '~' and before anything else.
+      //----------------------------------------------------------------------
+      inline void AppendKey(std::string & key, std::string_view v)
+      {
+        auto  isDigit = [] (char c) { return ((c >= '0') && (c <= '9')); };
+        size_t  start = key.size();
+        size_t  i = 0;
+        while (i < v.size()) {
+          for ( ; (i < v.size()) && (! isDigit(v[i])); ++i) {
+            key += (char)KeyByte(v[i]);
+          }
+          key += (char)2;
+          for ( ; (i < v.size()) && (v[i] == '0'); ++i)
+            ;
+          size_t  digits = i;
+          for ( ; (i < v.size()) && isDigit(v[i]); ++i)
+            ;
+          size_t  len = i - digits;
+          if (len < 0xFF) {
+            key += (char)len;
+          }
+          else {
+            key += (char)0xFF;
+            for (int shift = 24; shift >= 0; shift -= 8) {
+              key += (char)((len >> shift) & 0xFF);
+            }
+          }
+          key.append(v.data() + digits, len);
+        }
+        while (((key.size() - start) >= 2)
+               && (key[key.size() - 2] == 2) && (key.back() == 0)) {
+          key.resize(key.size() - 2);
+        }
+        key.append("\x02\x00\x02", 3);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Appends to @c key a sort key for a full version: the epoch as
+      //!  four big-endian bytes, then the AppendKey() keys for the
+      //!  upstream version and the revision.
+      //----------------------------------------------------------------------
+      inline void AppendKey(std::string & key, unsigned int epoch,
+                            std::string_view upstream,
+                            std::string_view revision)
+      {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+          key += (char)((epoch >> shift) & 0xFF);
+        }
+        AppendKey(key, upstream);
+        AppendKey(key, revision);
+      }
+
+    }  // namespace VersionCompare
+
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBVERSIONCOMPARE_HH_
@@ -40,8 +40,11 @@
 //!    implementations
 //---------------------------------------------------------------------------
 
-#include <regex>
+#include <cctype>
+#include <charconv>
+#include <limits>
 
+#include "DwmDebVersionCompare.hh"
 #include "DwmDebVersionString.hh"
 
 namespace Dwm {
@@ -55,49 +58,45 @@ namespace Dwm {
     //------------------------------------------------------------------------
     VersionPart::VersionPart(const string & part)
     {
-      size_t  i = 0;
-      while (i < part.size()) {
-        string  intstr;
-        for ( ; (i < part.size()) && isdigit(part[i]); ++i) {
-          intstr += part[i];
-        }
-        if (! intstr.empty()) {
-          _data.push_back(stoul(intstr));
-        }
-        string  sstr;
-        for ( ; (i < part.size()) && (! isdigit(part[i])); ++i) {
-          sstr += part[i];
-        }
-        if (! sstr.empty()) {
-          _data.push_back(sstr);
-        }
-      }
+      Parse(part);
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     VersionPart & VersionPart::operator = (const std::string & vp)
+    {
+      Parse(vp);
+      return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Splits @c vp into runs of digits and non-digits in one pass.  A run
+    //!  of digits too long for an unsigned long saturates.
+    //------------------------------------------------------------------------
+    void VersionPart::Parse(string_view vp)
     {
       _data.clear();
       size_t  i = 0;
       while (i < vp.size()) {
-        string  intstr;
-        for ( ; (i < vp.size()) && isdigit(vp[i]); ++i) {
-          intstr += vp[i];
-        }
-        if (! intstr.empty()) {
-          _data.push_back(stoul(intstr));
+        size_t  start = i;
+        for ( ; (i < vp.size()) && isdigit((unsigned char)vp[i]); ++i)
+          ;
+        if (i > start) {
+          unsigned long  n;
+          if (from_chars(vp.data() + start, vp.data() + i, n).ec
+              != errc()) {
+            n = numeric_limits<unsigned long>::max();
+          }
+          _data.push_back(n);
         }
-        string  sstr;
-        for ( ; (i < vp.size()) && (! isdigit(vp[i])); ++i) {
-          sstr += vp[i];
-        }
-        if (! sstr.empty()) {
-          _data.push_back(sstr);
+        start = i;
+        for ( ; (i < vp.size()) && (! isdigit((unsigned char)vp[i])); ++i)
+          ;
+        if (i > start) {
+          _data.push_back(string(vp.substr(start, i - start)));
         }
       }
-      return *this;
     }
 
     //------------------------------------------------------------------------
@@ -177,45 +176,39 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     VersionString::VersionString()
-        : _version()
+        : _str()
     {}
-  
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     VersionString::VersionString(const string & s)
-    {
-      static const regex  rgx("[^.]+", regex::ECMAScript|regex::optimize);
-      smatch  sm;
-      string  tmp = s;
-      while (regex_search(tmp, sm, rgx)) {
-        _version.push_back(VersionPart(sm.str()));
-        tmp = sm.suffix();
-      }
-    }
+        : _str(s)
+    {}
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     VersionString & VersionString::operator = (const std::string & v)
     {
-      _version.clear();
-      static const regex  rgx("[^.]+", regex::ECMAScript|regex::optimize);
-      smatch  sm;
-      string  tmp = v;
-      while (regex_search(tmp, sm, rgx)) {
-        _version.push_back(VersionPart(sm.str()));
-        tmp = sm.suffix();
-      }
+      _str = v;
       return *this;
     }
-  
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    int VersionString::Compare(const VersionString & vs) const
+    {
+      return VersionCompare::VerRevCmp(_str, vs._str);
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     bool VersionString::operator < (const VersionString & vs) const
     {
-      return (_version < vs._version);
+      return (Compare(vs) < 0);
     }
 
     //------------------------------------------------------------------------
@@ -223,7 +216,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool VersionString::operator > (const VersionString & vs) const
     {
-      return (_version > vs._version);
+      return (Compare(vs) > 0);
     }
 
     //------------------------------------------------------------------------
@@ -231,7 +224,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool VersionString::operator == (const VersionString & vs) const
     {
-      return (_version == vs._version);
+      return (Compare(vs) == 0);
     }
 
     //------------------------------------------------------------------------
@@ -239,7 +232,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool VersionString::operator != (const VersionString & vs) const
     {
-      return (_version != vs._version);
+      return (Compare(vs) != 0);
     }
 
     //------------------------------------------------------------------------
@@ -247,26 +240,15 @@ namespace Dwm {
     //------------------------------------------------------------------------
     VersionString::operator std::string () const
     {
-      string  rc;
-      string  sep;
-      for (const auto & p : _version) {
-        rc += sep + (string)p;
-        sep = ".";
-      }
-      return rc;
+      return _str;
     }
-  
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     ostream & operator << (ostream & os, const VersionString & vs)
     {
-      string  sep;
-      for (const auto & p : vs._version) {
-        os << sep << p;
-        sep = ".";
-      }
-      return os;
+      return (os << vs._str);
     }
 
     //------------------------------------------------------------------------
@@ -274,7 +256,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     void VersionString::clear()
     {
-      _version.clear();
+      _str.clear();
     }
   
 
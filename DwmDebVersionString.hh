@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -78,18 +79,19 @@ namespace Dwm {
     
     private:
       std::vector<std::variant<unsigned long,std::string>>  _data;
+
+      void Parse(std::string_view vp);
     };
 
     //------------------------------------------------------------------------
-    //!  Encapsulates a software version string, such as '13.4.2'.  This is
-    //!  an attempt to deal with various version numbering schemes and allow
-    //!  comparisons between them.  It won't work on every scheme; there is
-    //!  no universally used versioning scheme and some directly conflict with
-    //!  others in terms of machine parsing and comparisons.
+    //!  Encapsulates a software version string, such as '13.4.2' or the
+    //!  Debian revision '1ubuntu3~22.04'.  The string is kept verbatim and
+    //!  compared with the same algorithm as dpkg (see
+    //!  VersionCompare::VerRevCmp()), so no parsing is done up front and
+    //!  comparisons don't allocate.
     //!
-    //!  The accepted schemes have one or more strings separated by dots.
-    //!  This class stores each of the strings as a VersionPart in a 
-    //!  std::vector.  Most of the real work occurs in VersionPart.
+    //!  VersionPart is no longer used here; it's kept for code (and
+    //!  benchmarks) that want the old dot-separated comparison.
     //------------------------------------------------------------------------
     class VersionString
     {
@@ -101,13 +103,15 @@ namespace Dwm {
       bool operator > (const VersionString & vs) const;
       bool operator == (const VersionString & vs) const;
       bool operator != (const VersionString & vs) const;
+      int Compare(const VersionString & vs) const;
+      const std::string & String() const  { return _str; }
       operator std::string () const;
       friend std::ostream & operator << (std::ostream & os,
                                          const VersionString & vs);
       void clear();
     
     private:
-      std::vector<VersionPart>  _version;
+      std::string  _str;
     };
 
     
@@ -0,0 +1,197 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebWorkStealingPool.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::WorkStealingPool class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include "DwmDebWorkStealingPool.hh"
+
+namespace Dwm {
+
+  namespace Deb {
+
+    using namespace std;
+
+    //  Identifies the pool and worker index of the current thread, so that
+    //  Submit() from inside a task can push onto the local deque.
+    static thread_local const WorkStealingPool  *t_pool = nullptr;
+    static thread_local unsigned int             t_workerIdx = 0;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WorkStealingPool::WorkStealingPool(unsigned int numThreads)
+        : _queues(), _threads(), _mtx(), _workCv(), _doneCv(), _queued(0),
+          _pending(0), _sleepers(0), _nextQueue(0), _stop(false)
+    {
+      if (numThreads < 1) {
+        numThreads = 1;
+      }
+      for (unsigned int i = 0; i < numThreads; ++i) {
+        _queues.push_back(make_unique<WorkerQueue>());
+      }
+      for (unsigned int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&WorkStealingPool::Run, this, i);
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WorkStealingPool::~WorkStealingPool()
+    {
+      Wait();
+      {
+        lock_guard<mutex>  lck(_mtx);
+        _stop = true;
+      }
+      _workCv.notify_all();
+      for (auto & thr : _threads) {
+        thr.join();
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  _queued is counted before the push, so it's never less than the
+    //!  number of tasks in the deques.  A worker going to sleep counts
+    //!  itself in _sleepers before checking _queued, and we check
+    //!  _sleepers after counting _queued (both sequentially consistent),
+    //!  so either it sees the task or we see it and wake it.
+    //------------------------------------------------------------------------
+    void WorkStealingPool::Submit(Task task)
+    {
+      unsigned int  idx = ((t_pool == this) ? t_workerIdx
+                           : (_nextQueue++ % _queues.size()));
+      ++_pending;
+      ++_queued;
+      {
+        lock_guard<mutex>  lck(_queues[idx]->mtx);
+        _queues[idx]->tasks.push_back(move(task));
+      }
+      if (_sleepers > 0) {
+        lock_guard<mutex>  lck(_mtx);
+        _workCv.notify_one();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void WorkStealingPool::Wait()
+    {
+      unique_lock<mutex>  lck(_mtx);
+      _doneCv.wait(lck, [this] { return (0 == _pending); });
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    unsigned int WorkStealingPool::OnlineCpus()
+    {
+      long  ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+      return (ncpus > 0) ? ncpus : 1;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Pops from the back of our own deque, else steals from the front of
+    //!  someone else's.
+    //------------------------------------------------------------------------
+    bool WorkStealingPool::Take(unsigned int idx, Task & task)
+    {
+      {
+        WorkerQueue  & q = *_queues[idx];
+        lock_guard<mutex>  lck(q.mtx);
+        if (! q.tasks.empty()) {
+          task = move(q.tasks.back());
+          q.tasks.pop_back();
+          return true;
+        }
+      }
+      for (size_t i = 1; i < _queues.size(); ++i) {
+        WorkerQueue  & q = *_queues[(idx + i) % _queues.size()];
+        lock_guard<mutex>  lck(q.mtx);
+        if (! q.tasks.empty()) {
+          task = move(q.tasks.front());
+          q.tasks.pop_front();
+          return true;
+        }
+      }
+      return false;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void WorkStealingPool::Run(unsigned int idx)
+    {
+      t_pool = this;
+      t_workerIdx = idx;
+      Task  task;
+      for (;;) {
+        if (Take(idx, task)) {
+          --_queued;
+          task(idx);
+          task = nullptr;
+          if (1 == _pending--) {
+            lock_guard<mutex>  lck(_mtx);
+            _doneCv.notify_all();
+          }
+          continue;
+        }
+        //  Every deque was empty.  Sleep until something is queued.
+        unique_lock<mutex>  lck(_mtx);
+        if (_stop) {
+          break;
+        }
+        ++_sleepers;
+        _workCv.wait(lck, [this] { return (_stop || (_queued > 0)); });
+        --_sleepers;
+      }
+      t_pool = nullptr;
+      return;
+    }
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
@@ -0,0 +1,139 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmDebWorkStealingPool.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::WorkStealingPool class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMDEBWORKSTEALINGPOOL_HH_
+#define _DWMDEBWORKSTEALINGPOOL_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Deb {
+
+    //------------------------------------------------------------------------
+    //!  A fixed-size pool of worker threads, each with its own task deque.
+    //!  A worker takes tasks from the back of its own deque and, when that
+    //!  runs dry, steals from the front of the other workers' deques.
+    //!  Tasks submitted from inside a worker go onto that worker's deque,
+    //!  so recursive work (directory walks, for example) stays local until
+    //!  someone else is idle.  The deques have their own locks; the
+    //!  pool-wide mutex is only taken to sleep when every deque is empty,
+    //!  to wake a sleeping worker, and to wait for the pool to drain.
+    //!
+    //!  Each task is handed the index of the worker running it, which is
+    //!  in the range [0, NumThreads()).  Callers use it to index per-worker
+    //!  result containers so the tasks themselves need no locking.
+    //------------------------------------------------------------------------
+    class WorkStealingPool
+    {
+    public:
+      using Task = std::function<void(unsigned int)>;
+      
+      //----------------------------------------------------------------------
+      //!  Starts @c numThreads workers (at least one).
+      //----------------------------------------------------------------------
+      WorkStealingPool(unsigned int numThreads);
+
+      //----------------------------------------------------------------------
+      //!  Finishes all outstanding tasks and joins the workers.
+      //----------------------------------------------------------------------
+      ~WorkStealingPool();
+
+      WorkStealingPool(const WorkStealingPool &) = delete;
+      WorkStealingPool & operator = (const WorkStealingPool &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  
+      //----------------------------------------------------------------------
+      unsigned int NumThreads() const
+      { return _threads.size(); }
+      
+      //----------------------------------------------------------------------
+      //!  Queues @c task.  May be called from any thread, including from
+      //!  inside a running task.
+      //----------------------------------------------------------------------
+      void Submit(Task task);
+
+      //----------------------------------------------------------------------
+      //!  Blocks until every submitted task (including tasks submitted by
+      //!  other tasks) has finished.  Must not be called from a worker.
+      //----------------------------------------------------------------------
+      void Wait();
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of online CPUs, or 1 if it can't be determined.
+      //----------------------------------------------------------------------
+      static unsigned int OnlineCpus();
+      
+    private:
+      struct WorkerQueue
+      {
+        std::mutex        mtx;
+        std::deque<Task>  tasks;
+      };
+      
+      std::vector<std::unique_ptr<WorkerQueue>>  _queues;
+      std::vector<std::thread>                   _threads;
+      std::mutex                                 _mtx;
+      std::condition_variable                    _workCv;
+      std::condition_variable                    _doneCv;
+      std::atomic<size_t>                        _queued;
+      std::atomic<size_t>                        _pending;
+      std::atomic<unsigned int>                  _sleepers;
+      std::atomic<unsigned int>                  _nextQueue;
+      bool                                       _stop;
+
+      void Run(unsigned int idx);
+      bool Take(unsigned int idx, Task & task);
+    };
+    
+  }  // namespace Deb
+
+}  // namespace Dwm
+
+#endif  // _DWMDEBWORKSTEALINGPOOL_HH_
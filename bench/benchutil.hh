@@ -0,0 +1,84 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file benchutil.hh
+//!  \author Daniel W. McRobb
+//!  \brief helpers shared by the benchmarks
+//---------------------------------------------------------------------------
+
+#ifndef _BENCHUTIL_HH_
+#define _BENCHUTIL_HH_
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BenchUtil {
+
+  typedef std::chrono::steady_clock  Clock;
+
+  //--------------------------------------------------------------------------
+  //!  Returns the seconds elapsed since @c start.
+  //--------------------------------------------------------------------------
+  inline double Seconds(Clock::time_point start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  //--------------------------------------------------------------------------
+  //!  Appends the value of every 'Version:' field in @c path (a dpkg
+  //!  status file or an apt Packages file) to @c versions.  Returns false
+  //!  if there were none.
+  //--------------------------------------------------------------------------
+  inline bool ReadVersions(const std::string & path,
+                           std::vector<std::string> & versions)
+  {
+    std::ifstream  is(path);
+    std::string    line;
+    bool           rc = false;
+    while (std::getline(is, line)) {
+      if (line.compare(0, 9, "Version: ") == 0) {
+        versions.push_back(line.substr(9));
+        rc = true;
+      }
+    }
+    return rc;
+  }
+
+}  // namespace BenchUtil
+
+#endif  // _BENCHUTIL_HH_
@@ -0,0 +1,205 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file controlparsebench.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Deb::Control::Parse() throughput as the number of threads
+//!    parsing concurrently grows
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DwmDebControl.hh"
+
+#include "benchutil.hh"
+
+using namespace std;
+
+using BenchUtil::Clock, BenchUtil::Seconds;
+
+//----------------------------------------------------------------------------
+//!  Writes a control file with @c numDepends entries in each of
+//!  Pre-Depends and Depends to @c path.
+//----------------------------------------------------------------------------
+static bool WriteControl(const string & path, int numDepends)
+{
+  ofstream  os(path);
+  os << "Package: benchpkg\n"
+     << "Section: devel\n"
+     << "Priority: optional\n"
+     << "Maintainer: Nobody <nobody@example.com>\n"
+     << "Version: 1.2.3\n"
+     << "Architecture: amd64\n"
+     << "Homepage: https://example.com/benchpkg\n";
+  for (const char *field : { "Pre-Depends:", "Depends:" }) {
+    os << field;
+    for (int i = 0; i < numDepends; ++i) {
+      os << (i ? ",\n " : " ") << "libbench" << i
+         << " (>= " << (i % 7) << ':' << i << '.' << (i % 13)
+         << "-" << (i % 5) << ')';
+    }
+    os << '\n';
+  }
+  os << "Description: control file parser benchmark\n"
+     << " A long description\n"
+     << " spanning two lines.\n";
+  return os.good();
+}
+
+//----------------------------------------------------------------------------
+//!  Parses @c path @c parses times, counting any parse that fails or
+//!  doesn't render as @c expected in @c failures.
+//----------------------------------------------------------------------------
+static void ParseLoop(const string & path, int parses,
+                      const string & expected, size_t & failures)
+{
+  for (int i = 0; i < parses; ++i) {
+    Dwm::Deb::Control  ctrl;
+    ostringstream      os;
+    if ((! ctrl.Parse(path)) || ((os << ctrl), os.str() != expected)) {
+      ++failures;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  parses = 2000;
+  int  maxThreads = thread::hardware_concurrency();
+  int  numDepends = 50;
+  int  opt;
+  while ((opt = getopt(argc, argv, "d:j:n:")) != -1) {
+    switch (opt) {
+      case 'd':  numDepends = stoi(optarg);  break;
+      case 'j':  maxThreads = stoi(optarg);  break;
+      case 'n':  parses = stoi(optarg);      break;
+      default:
+        cerr << "usage: " << argv[0]
+             << " [-d depends] [-j maxThreads] [-n parsesPerThread]"
+             << " [controlFile]\n";
+        return 1;
+    }
+  }
+  if (maxThreads < 1) {
+    maxThreads = 1;
+  }
+
+  string  path;
+  bool    generated = (optind >= argc);
+  if (generated) {
+    char  tmpl[] = "/tmp/controlparsebench.XXXXXX";
+    int   fd = mkstemp(tmpl);
+    if (fd < 0) {
+      cerr << "mkstemp() failed\n";
+      return 1;
+    }
+    close(fd);
+    path = tmpl;
+    if (! WriteControl(path, numDepends)) {
+      cerr << "failed to write " << path << '\n';
+      unlink(path.c_str());
+      return 1;
+    }
+  }
+  else {
+    path = argv[optind];
+  }
+
+  Dwm::Deb::Control  refCtrl;
+  if (! refCtrl.Parse(path)) {
+    cerr << "failed to parse " << path << '\n';
+    if (generated) {
+      unlink(path.c_str());
+    }
+    return 1;
+  }
+  ostringstream  refos;
+  refos << refCtrl;
+  string  expected = refos.str();
+
+  vector<int>  threadCounts;
+  for (int n = 1; n < maxThreads; n *= 2) {
+    threadCounts.push_back(n);
+  }
+  threadCounts.push_back(maxThreads);
+
+  size_t  totalFailures = 0;
+  double  base = 0;
+  cout << setw(8) << left << "threads" << setw(14) << "parses/s"
+       << "speedup\n";
+  for (int n : threadCounts) {
+    vector<size_t>  failures(n, 0);
+    vector<thread>  threads;
+    auto  start = Clock::now();
+    for (int t = 0; t < n; ++t) {
+      threads.emplace_back(ParseLoop, cref(path), parses, cref(expected),
+                           ref(failures[t]));
+    }
+    for (auto & t : threads) {
+      t.join();
+    }
+    double  secs = Seconds(start);
+    double  rate = (double(n) * parses) / secs;
+    if (n == 1) {
+      base = rate;
+    }
+    for (auto f : failures) {
+      totalFailures += f;
+    }
+    cout << setw(8) << n << setw(14) << rate << (rate / base) << '\n';
+  }
+  cout << "failures: " << totalFailures << '\n';
+
+  if (generated) {
+    unlink(path.c_str());
+  }
+  return (totalFailures ? 1 : 0);
+}
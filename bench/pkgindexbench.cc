@@ -0,0 +1,204 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file pkgindexbench.cc
+//!  \author Daniel W. McRobb
+//!  \brief compare package lookups through 'dpkg -S' with lookups in a
+//!    Dwm::Deb::PackageIndex
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DwmDebPackageIndex.hh"
+
+#include "benchutil.hh"
+
+using namespace std;
+
+using BenchUtil::Clock, BenchUtil::Seconds;
+
+//----------------------------------------------------------------------------
+//!  What mkdebcontrol did before the index: one 'dpkg -S' pipeline per
+//!  file, keeping the first package on the last line of output.
+//----------------------------------------------------------------------------
+static string DpkgSearch(const string & file)
+{
+  string  rc;
+  string  cmd("dpkg -S " + file + " 2>/dev/null | tail -1");
+  FILE   *cmdpipe = popen(cmd.c_str(), "r");
+  if (cmdpipe) {
+    char  line[4096];
+    while (fgets(line, sizeof(line), cmdpipe) != nullptr) {
+      string  s(line);
+      rc = s.substr(0, s.find_first_of(":,"));
+    }
+    pclose(cmdpipe);
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static string IndexSearch(const Dwm::Deb::PackageIndex & index,
+                          const string & file)
+{
+  string          rc;
+  vector<string>  owners;
+  if ((file.find('/') != string::npos)
+      ? index.FindPath(file, owners) : index.FindBasename(file, owners)) {
+    rc = owners.front().substr(0, owners.front().find(':'));
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  string  infoDir("/var/lib/dpkg/info");
+  string  indexFile;
+  int     iterations = 1000;
+  int     opt;
+  while ((opt = getopt(argc, argv, "d:f:n:")) != -1) {
+    switch (opt) {
+      case 'd':  infoDir = optarg;             break;
+      case 'f':  indexFile = optarg;           break;
+      case 'n':  iterations = stoi(optarg);    break;
+      default:
+        cerr << "usage: " << argv[0]
+             << " [-d infoDir] [-f indexFile] [-n iterations]"
+             << " [path_or_soname...]\n";
+        return 1;
+    }
+  }
+  vector<string>  files(argv + optind, argv + argc);
+  if (files.empty()) {
+    files = { "libc.so.6", "libm.so.6", "libz.so.1", "libstdc++.so.6",
+              "libgcc_s.so.1", "libselinux.so.1", "libacl.so.1",
+              "/lib/x86_64-linux-gnu/libc.so.6",
+              "/lib/x86_64-linux-gnu/libz.so.1",
+              "/usr/lib/x86_64-linux-gnu/libstdc++.so.6" };
+  }
+
+  auto                    start = Clock::now();
+  Dwm::Deb::PackageIndex  index;
+  if (! index.Load(infoDir)) {
+    cerr << "Failed to load package index from " << infoDir << '\n';
+    return 1;
+  }
+  double  loadSecs = Seconds(start);
+  
+  start = Clock::now();
+  size_t  found = 0;
+  for (int i = 0; i < iterations; ++i) {
+    for (const auto & file : files) {
+      found += (! IndexSearch(index, file).empty());
+    }
+  }
+  double  indexSecs = Seconds(start);
+
+  //  With an index file, make sure it's current and then time loading
+  //  and searching it the way a warm mkdebcontrol -c run would.
+  double  mapSecs = 0, mappedSecs = 0;
+  if (! indexFile.empty()) {
+    Dwm::Deb::PackageIndex  warmup;
+    warmup.Load(infoDir, indexFile);
+    start = Clock::now();
+    Dwm::Deb::PackageIndex  mapped;
+    if ((! mapped.Load(infoDir, indexFile)) || (! mapped.IsMapped())) {
+      cerr << "Failed to map index file " << indexFile << '\n';
+      return 1;
+    }
+    mapSecs = Seconds(start);
+    start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      for (const auto & file : files) {
+        IndexSearch(mapped, file);
+      }
+    }
+    mappedSecs = Seconds(start);
+    for (const auto & file : files) {
+      if (IndexSearch(mapped, file) != IndexSearch(index, file)) {
+        cerr << "mapped index differs for " << file << '\n';
+        return 1;
+      }
+    }
+  }
+  
+  start = Clock::now();
+  vector<string>  dpkgPkgs;
+  for (const auto & file : files) {
+    dpkgPkgs.push_back(DpkgSearch(file));
+  }
+  double  dpkgSecs = Seconds(start);
+  
+  //  Bare sonames are patterns to dpkg -S, which may then report a
+  //  package that merely has the soname as part of a longer path (e.g. a
+  //  -dev package), so a few mismatches are expected.
+  size_t  mismatches = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    string  pkg = IndexSearch(index, files[i]);
+    if (pkg != dpkgPkgs[i]) {
+      cerr << "mismatch: " << files[i] << ": index '" << pkg
+           << "', dpkg -S '" << dpkgPkgs[i] << "'\n";
+      ++mismatches;
+    }
+  }
+
+  size_t  lookups = files.size() * iterations;
+  cout << "index load:   " << index.NumPackages() << " packages, "
+       << index.NumPaths() << " paths in " << loadSecs * 1e3 << " ms\n"
+       << "index lookup: " << (indexSecs * 1e9) / lookups << " ns/lookup ("
+       << lookups << " lookups, " << found << " found)\n";
+  if (! indexFile.empty()) {
+    cout << "mapped load:  " << mapSecs * 1e3 << " ms\n"
+         << "mapped lookup: " << (mappedSecs * 1e9) / lookups
+         << " ns/lookup\n";
+  }
+  cout       << "dpkg -S:      " << (dpkgSecs * 1e6) / files.size()
+       << " us/lookup (" << files.size() << " lookups)\n"
+       << "mismatches:   " << mismatches << '\n';
+  return 0;
+}
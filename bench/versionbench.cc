@@ -0,0 +1,334 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file versionbench.cc
+//!  \author Daniel W. McRobb
+//!  \brief micro-benchmarks for version parsing, comparison, sorting and
+//!    dependency sets over generated corpora, with JSON output
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "DwmDebDependSet.hh"
+#include "DwmDebPkgDepend.hh"
+#include "DwmDebPkgVersion.hh"
+#include "DwmDebVersionString.hh"
+
+#include "benchutil.hh"
+
+using namespace std;
+using Dwm::Deb::PkgDepend, Dwm::Deb::PkgVersion, Dwm::Deb::VersionPart,
+  Dwm::Deb::VersionString;
+
+using BenchUtil::Clock, BenchUtil::Seconds;
+
+//  Every allocation in the process, counted by the operator new below.
+static size_t  g_allocs = 0;
+
+void *operator new(size_t size)
+{
+  ++g_allocs;
+  if (void *p = malloc(size ? size : 1)) {
+    return p;
+  }
+  throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+//----------------------------------------------------------------------------
+//!  Returns @c n version strings shaped like the ones in Debian archives:
+//!  an occasional epoch, two to four numeric components, sometimes a
+//!  '~rc', '+dfsg' or letter suffix, and usually a revision, sometimes
+//!  with a vendor suffix.  The same @c n always gives the same corpus.
+//----------------------------------------------------------------------------
+static vector<string> Corpus(size_t n)
+{
+  static const char * const  suffixes[] = {
+    "", "", "", "", "~rc1", "~beta2", "+dfsg", "+dfsg1", "a", "+git20230101"
+  };
+  static const char * const  vendors[] = {
+    "", "", "", "ubuntu1", "ubuntu0.22.04.1", "+deb12u1", "build1"
+  };
+  mt19937         rng(n);
+  vector<string>  rc;
+  rc.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    string  s;
+    if ((rng() % 10) == 0) {
+      s += to_string(1 + (rng() % 3)) + ':';
+    }
+    int  parts = 2 + (rng() % 3);
+    for (int p = 0; p < parts; ++p) {
+      s += (p ? "." : "") + to_string(rng() % ((p == 0) ? 10 : 40));
+    }
+    s += suffixes[rng() % (sizeof(suffixes) / sizeof(suffixes[0]))];
+    if ((rng() % 5) != 0) {
+      s += '-' + to_string(1 + (rng() % 12));
+      s += vendors[rng() % (sizeof(vendors) / sizeof(vendors[0]))];
+    }
+    rc.push_back(s);
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+struct Result
+{
+  string  name;
+  size_t  size;
+  size_t  ops;
+  double  secs;
+  size_t  allocs;
+};
+
+static vector<Result>  g_results;
+static double          g_minSecs = 0.2;
+
+//----------------------------------------------------------------------------
+//!  Runs @c fn, which performs @c opsPerRun operations and returns the
+//!  time they took, until at least g_minSecs have been measured, and
+//!  records the totals.  Allocations are counted only inside @c fn, so
+//!  @c fn should do untimed setup before taking its start time and
+//!  subtract the allocations it made there from g_allocs.
+//----------------------------------------------------------------------------
+static void Run(const string & name, size_t size, size_t opsPerRun,
+                const function<double()> & fn)
+{
+  Result  r = { name, size, 0, 0, 0 };
+  do {
+    size_t  allocs = g_allocs;
+    r.secs += fn();
+    r.allocs += (g_allocs - allocs);
+    r.ops += opsPerRun;
+  } while (r.secs < g_minSecs);
+  g_results.push_back(r);
+  cerr << name << " n=" << size << ": " << (r.secs * 1e9) / r.ops
+       << " ns/op\n";
+}
+
+//----------------------------------------------------------------------------
+//!  The upstream part of a version string, what VersionPart was given.
+//----------------------------------------------------------------------------
+static string Upstream(const string & s)
+{
+  size_t  colon = s.find(':');
+  size_t  start = ((colon == string::npos) ? 0 : (colon + 1));
+  return s.substr(start, s.find('-', start) - start);
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void BenchSize(size_t n)
+{
+  vector<string>  strs = Corpus(n);
+  vector<string>  upstreams;
+  for (const auto & s : strs) {
+    upstreams.push_back(Upstream(s));
+  }
+  volatile size_t  sink = 0;
+
+  Run("parse/VersionPart", n, n, [&] {
+    auto  start = Clock::now();
+    for (const auto & s : upstreams) {
+      VersionPart  vp(s);
+      sink += (vp == vp);
+    }
+    return Seconds(start);
+  });
+  Run("parse/VersionString", n, n, [&] {
+    auto  start = Clock::now();
+    for (const auto & s : upstreams) {
+      VersionString  vs(s);
+      sink += (vs == vs);
+    }
+    return Seconds(start);
+  });
+  Run("parse/PkgVersion", n, n, [&] {
+    auto  start = Clock::now();
+    for (const auto & s : strs) {
+      PkgVersion  v;
+      sink += v.FromString(s);
+    }
+    return Seconds(start);
+  });
+
+  size_t                 before = g_allocs;
+  vector<VersionPart>    parts(upstreams.begin(), upstreams.end());
+  vector<VersionString>  vstrs(upstreams.begin(), upstreams.end());
+  vector<PkgVersion>     versions(n);
+  vector<PkgDepend>      deps;
+  for (size_t i = 0; i < n; ++i) {
+    versions[i].FromString(strs[i]);
+    deps.push_back(PkgDepend("lib" + to_string(i % 1000), ">=",
+                             versions[i]));
+  }
+  g_allocs = before;
+
+  Run("compare/VersionPart", n, n, [&] {
+    auto  start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+      sink += (parts[i] < parts[(i + 1) % n]);
+    }
+    return Seconds(start);
+  });
+  Run("compare/VersionString", n, n, [&] {
+    auto  start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+      sink += (vstrs[i] < vstrs[(i + 1) % n]);
+    }
+    return Seconds(start);
+  });
+  Run("compare/PkgVersion", n, n, [&] {
+    auto  start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+      sink += (versions[i] < versions[(i + 1) % n]);
+    }
+    return Seconds(start);
+  });
+  Run("compare/PkgDepend", n, n, [&] {
+    auto  start = Clock::now();
+    for (size_t i = 0; i < n; ++i) {
+      sink += (deps[i] < deps[(i + 1) % n]);
+    }
+    return Seconds(start);
+  });
+  Run("sort/PkgVersion", n, n, [&] {
+    size_t  allocs = g_allocs;
+    vector<PkgVersion>  v(versions);
+    g_allocs = allocs;
+    auto  start = Clock::now();
+    sort(v.begin(), v.end());
+    double  secs = Seconds(start);
+    allocs = g_allocs;
+    v.clear();
+    v.shrink_to_fit();
+    g_allocs = allocs;
+    return secs;
+  });
+  Run("set-insert/PkgDepend", n, n, [&] {
+    auto  start = Clock::now();
+    double  secs;
+    {
+      set<PkgDepend>  s;
+      for (const auto & dep : deps) {
+        s.insert(dep);
+      }
+      secs = Seconds(start);
+      sink += s.size();
+    }
+    return secs;
+  });
+  Run("set-insert/DependSet", n, n, [&] {
+    auto  start = Clock::now();
+    double  secs;
+    {
+      Dwm::Deb::DependSet  s;
+      for (const auto & dep : deps) {
+        s.Add(dep);
+      }
+      secs = Seconds(start);
+      sink += s.size();
+    }
+    return secs;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void PrintJson(ostream & os)
+{
+  os << "{\n  \"benchmark\": \"versionbench\",\n  \"results\": [";
+  string  sep("\n");
+  for (const auto & r : g_results) {
+    os << sep << "    { \"name\": \"" << r.name << "\", \"size\": " << r.size
+       << ", \"ops\": " << r.ops
+       << ", \"ns_per_op\": " << (r.secs * 1e9) / r.ops
+       << ", \"allocs_per_op\": " << (double)r.allocs / r.ops
+       << ", \"ops_per_sec\": " << r.ops / r.secs << " }";
+    sep = ",\n";
+  }
+  os << "\n  ]\n}\n";
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  size_t  maxSize = 1000000;
+  int     opt;
+  while ((opt = getopt(argc, argv, "m:t:")) != -1) {
+    switch (opt) {
+      case 'm':  maxSize = stoul(optarg);     break;
+      case 't':  g_minSecs = stod(optarg);    break;
+      default:
+        cerr << "usage: " << argv[0] << " [-m maxCorpusSize]"
+             << " [-t minSecondsPerResult]\n";
+        return 1;
+    }
+  }
+  for (size_t n = 10; n <= maxSize; n *= 10) {
+    BenchSize(n);
+  }
+  PrintJson(cout);
+  return 0;
+}
@@ -0,0 +1,251 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file versioncmpbench.cc
+//!  \author Daniel W. McRobb
+//!  \brief compare the old VersionPart-based version comparison with
+//!    Dwm::Deb::VersionCompare::VerRevCmp() and with PkgVersion sort keys
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DwmDebPkgVersion.hh"
+#include "DwmDebVersionCompare.hh"
+#include "fuzz/dpkgcmp.hh"
+
+#include "benchutil.hh"
+
+using namespace std;
+
+using BenchUtil::Clock, BenchUtil::ReadVersions, BenchUtil::Seconds;
+using DpkgCmp::Sign;
+
+//----------------------------------------------------------------------------
+//!  What PkgVersion held before VerRevCmp(): the epoch and the upstream
+//!  version split on '.' into VersionParts.  The release wasn't used
+//!  for ordering.
+//----------------------------------------------------------------------------
+struct LegacyVersion
+{
+  int                            epoch;
+  vector<Dwm::Deb::VersionPart>  parts;
+
+  LegacyVersion(const Dwm::Deb::PkgVersion & v)
+      : epoch(v.Epoch()), parts()
+  {
+    const string & s = v.Version().String();
+    size_t  start = 0;
+    while (start < s.size()) {
+      size_t  end = s.find('.', start);
+      if (end == string::npos) {
+        end = s.size();
+      }
+      if (end > start) {
+        parts.push_back(Dwm::Deb::VersionPart(s.substr(start, end - start)));
+      }
+      start = end + 1;
+    }
+  }
+
+  int Compare(const LegacyVersion & v) const
+  {
+    if (epoch != v.epoch) {
+      return ((epoch < v.epoch) ? -1 : 1);
+    }
+    return ((parts < v.parts) ? -1 : ((v.parts < parts) ? 1 : 0));
+  }
+};
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static int VerRevCompare(const Dwm::Deb::PkgVersion & a,
+                         const Dwm::Deb::PkgVersion & b)
+{
+  return Dwm::Deb::VersionCompare::Compare(a.Epoch(), a.Version().String(),
+                                           a.Release(),
+                                           b.Epoch(), b.Version().String(),
+                                           b.Release());
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  string  statusFile("/var/lib/dpkg/status");
+  int     iterations = 100;
+  size_t  dpkgChecks = 0;
+  int     opt;
+  while ((opt = getopt(argc, argv, "c:n:s:")) != -1) {
+    switch (opt) {
+      case 'c':  dpkgChecks = stoul(optarg);   break;
+      case 'n':  iterations = stoi(optarg);    break;
+      case 's':  statusFile = optarg;          break;
+      default:
+        cerr << "usage: " << argv[0]
+             << " [-c dpkgChecks] [-n iterations] [-s statusFile]\n";
+        return 1;
+    }
+  }
+
+  vector<string>  strs;
+  if (! ReadVersions(statusFile, strs)) {
+    strs = { "1.0", "1.0-1", "1.0-1ubuntu1", "1.0~rc1", "1.0+dfsg-2",
+             "1:0.9", "2.34-0ubuntu3", "2.36.1-8", "3.1~", "3.1-3",
+             "1.2.3a", "1.2.3", "1.02.3", "10.0", "9.99", "2:1.0",
+             "0.0~git20230101.abc123-1", "1.0.0+really0.9-1" };
+  }
+  vector<Dwm::Deb::PkgVersion>  versions;
+  for (const auto & s : strs) {
+    Dwm::Deb::PkgVersion  v;
+    if (v.FromString(s)) {
+      versions.push_back(v);
+    }
+  }
+  mt19937  rng(42);
+  shuffle(versions.begin(), versions.end(), rng);
+
+  auto  start = Clock::now();
+  vector<LegacyVersion>  legacy(versions.begin(), versions.end());
+  double  legacyParseSecs = Seconds(start);
+
+  size_t  n = versions.size();
+  long    sum = 0;
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      sum += Sign(legacy[j].Compare(legacy[(j + 1) % n]));
+    }
+  }
+  double  legacySecs = Seconds(start);
+
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      sum += Sign(VerRevCompare(versions[j], versions[(j + 1) % n]));
+    }
+  }
+  double  verrevSecs = Seconds(start);
+
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      sum += Sign(versions[j].Compare(versions[(j + 1) % n]));
+    }
+  }
+  double  keySecs = Seconds(start);
+
+  //  Sort keys must order exactly like VerRevCmp(), for every pair.
+  size_t  keyMismatches = 0;
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t k = 0; k < n; ++k) {
+      if (Sign(versions[j].Compare(versions[k]))
+          != Sign(VerRevCompare(versions[j], versions[k]))) {
+        if (! keyMismatches++) {
+          cerr << "key mismatch: " << versions[j] << " vs "
+               << versions[k] << '\n';
+        }
+      }
+    }
+  }
+
+  //  The legacy comparison ignores the release and treats '~' like any
+  //  other character, so some disagreements are expected.
+  size_t  disagreements = 0;
+  for (size_t j = 0; j < n; ++j) {
+    disagreements += (Sign(legacy[j].Compare(legacy[(j + 1) % n]))
+                      != Sign(VerRevCompare(versions[j],
+                                            versions[(j + 1) % n])));
+  }
+
+  //  VerRevCmp() should always agree with dpkg.
+  size_t  dpkgMismatches = 0;
+  vector<pair<string,string>>  dpkgPairs;
+  for (size_t j = 0; j < min(dpkgChecks, n); ++j) {
+    ostringstream  as, bs;
+    as << versions[j];
+    bs << versions[(j + 1) % n];
+    dpkgPairs.push_back({as.str(), bs.str()});
+  }
+  vector<int>  dpkgSigns;
+  if ((! dpkgPairs.empty()) && (! DpkgCmp::Compare(dpkgPairs, dpkgSigns))) {
+    cerr << "failed to run dpkg --compare-versions\n";
+    dpkgSigns.assign(dpkgPairs.size(), 2);
+  }
+  for (size_t j = 0; j < dpkgPairs.size(); ++j) {
+    int  d = dpkgSigns[j];
+    if (d == 2) {
+      continue;
+    }
+    int  ours = Sign(VerRevCompare(versions[j], versions[(j + 1) % n]));
+    if (d != ours) {
+      cerr << "dpkg mismatch: " << dpkgPairs[j].first << " vs "
+           << dpkgPairs[j].second << ": dpkg " << d << ", VerRevCmp "
+           << ours << '\n';
+      ++dpkgMismatches;
+    }
+  }
+
+  size_t  compares = n * iterations;
+  cout << "versions:       " << n << " (" << sum << ")\n"
+       << "legacy parse:   " << (legacyParseSecs * 1e9) / n
+       << " ns/version\n"
+       << "legacy compare: " << (legacySecs * 1e9) / compares
+       << " ns/compare\n"
+       << "VerRevCmp:      " << (verrevSecs * 1e9) / compares
+       << " ns/compare\n"
+       << "sort key:       " << (keySecs * 1e9) / compares
+       << " ns/compare\n"
+       << "key mismatches: " << keyMismatches << " of " << n * n << '\n'
+       << "disagreements:  " << disagreements << " of " << n << '\n';
+  if (dpkgChecks) {
+    cout << "dpkg mismatches: " << dpkgMismatches << " of "
+         << min(dpkgChecks, n) << '\n';
+  }
+  return ((dpkgMismatches || keyMismatches) ? 1 : 0);
+}
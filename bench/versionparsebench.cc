@@ -0,0 +1,280 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file versionparsebench.cc
+//!  \author Daniel W. McRobb
+//!  \brief compare the old regex-based version parsing with
+//!    Dwm::Deb::PkgVersion::FromString() and Dwm::Deb::VersionPart
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "DwmDebPkgVersion.hh"
+
+#include "benchutil.hh"
+
+using namespace std;
+
+using BenchUtil::Clock, BenchUtil::ReadVersions, BenchUtil::Seconds;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+struct Parsed
+{
+  int     epoch = 0;
+  string  version;
+  string  release;
+
+  bool operator == (const Parsed & p) const
+  {
+    return ((epoch == p.epoch) && (version == p.version)
+            && (release == p.release));
+  }
+};
+
+//----------------------------------------------------------------------------
+//!  What PkgVersion::FromString() did before: up to three regex_match()
+//!  calls.
+//----------------------------------------------------------------------------
+static bool LegacyFromString(const string & s, Parsed & p)
+{
+  p = Parsed();
+  bool  rc = false;
+  static regex  full("([0-9]+)[:]([^-]+)\\-(.+)",
+                     regex::ECMAScript|regex::optimize);
+  smatch        sm;
+  if (regex_match(s, sm, full)) {
+    p.epoch = atoi(sm[1].str().c_str());
+    p.version = sm[2].str();
+    p.release = sm[3].str();
+    rc = true;
+  }
+  else {
+    static regex  epochvers("([0-9]+)[:]([^-]+)",
+                            regex::ECMAScript|regex::optimize);
+    if (regex_match(s, sm, epochvers)) {
+      p.epoch = atoi(sm[1].str().c_str());
+      p.version = sm[2].str();
+      rc = true;
+    }
+    else {
+      static regex  versrelease("([^-]+)\\-(.+)",
+                                regex::ECMAScript|regex::optimize);
+      if (regex_match(s, sm, versrelease)) {
+        p.version = sm[1].str();
+        p.release = sm[2].str();
+        rc = true;
+      }
+      else if (! s.empty()) {
+        p.version = s;
+        rc = true;
+      }
+    }
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  What VersionString's constructor did before: regex_search() for each
+//!  dot-separated part, copying the suffix each time, and VersionPart
+//!  built each run a character at a time.  Returns the parts rendered
+//!  the way VersionPart renders them.
+//----------------------------------------------------------------------------
+static vector<string> LegacySplit(const string & s)
+{
+  vector<string>  rc;
+  static const regex  rgx("[^.]+", regex::ECMAScript|regex::optimize);
+  smatch  sm;
+  string  tmp = s;
+  while (regex_search(tmp, sm, rgx)) {
+    string  part = sm.str();
+    vector<variant<unsigned long,string>>  data;
+    size_t  i = 0;
+    while (i < part.size()) {
+      string  intstr;
+      for ( ; (i < part.size()) && isdigit(part[i]); ++i) {
+        intstr += part[i];
+      }
+      if (! intstr.empty()) {
+        data.push_back(stoul(intstr));
+      }
+      string  sstr;
+      for ( ; (i < part.size()) && (! isdigit(part[i])); ++i) {
+        sstr += part[i];
+      }
+      if (! sstr.empty()) {
+        data.push_back(sstr);
+      }
+    }
+    string  r;
+    for (const auto & d : data) {
+      r += (d.index() ? get<1>(d) : to_string(get<0>(d)));
+    }
+    rc.push_back(r);
+    tmp = sm.suffix();
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  The same split with std::string_view and the current VersionPart.
+//----------------------------------------------------------------------------
+static vector<string> Split(string_view s)
+{
+  vector<string>  rc;
+  size_t  start = 0;
+  while (start < s.size()) {
+    size_t  end = s.find('.', start);
+    if (end == s.npos) {
+      end = s.size();
+    }
+    if (end > start) {
+      rc.push_back(Dwm::Deb::VersionPart(string(s.substr(start,
+                                                           end - start))));
+    }
+    start = end + 1;
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  string  statusFile("/var/lib/dpkg/status");
+  int     iterations = 20;
+  int     opt;
+  while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+    switch (opt) {
+      case 'n':  iterations = stoi(optarg);    break;
+      case 's':  statusFile = optarg;          break;
+      default:
+        cerr << "usage: " << argv[0]
+             << " [-n iterations] [-s statusFile] [PackagesFile...]\n";
+        return 1;
+    }
+  }
+  vector<string>  versions;
+  ReadVersions(statusFile, versions);
+  for (int i = optind; i < argc; ++i) {
+    ReadVersions(argv[i], versions);
+  }
+  //  Odd cases the regexes handled in particular ways.
+  versions.insert(versions.end(),
+                  { "1.0", "1:2.3-4", "1:2.3-4-5", "1:-2", "1:2-", "1:",
+                    ":1.0", "a:1.0-1", "-1", "1-", "1.0-1\n2", "01:1.0",
+                    "1.0~rc1+dfsg-2ubuntu0.22.04.1", "2:1.02.003a..b",
+                    "99999999999999999999:1", "" });
+
+  size_t  mismatches = 0;
+  for (const auto & s : versions) {
+    Parsed                legacy;
+    bool                  legacyOk = LegacyFromString(s, legacy);
+    Dwm::Deb::PkgVersion  v;
+    bool                  ok = v.FromString(s);
+    Parsed                p;
+    p.epoch = v.Epoch();
+    p.version = v.Version().String();
+    p.release = v.Release();
+    //  atoi() of an epoch too big for an int is undefined; don't count it.
+    size_t  colon = s.find(':');
+    bool    bigEpoch = ((colon != string::npos) && (colon > 9));
+    //  The regexes release everything after the first '-'; FromString()
+    //  releases what follows the last one, as dpkg does.
+    bool    hyphens = (s.find('-') != s.rfind('-'));
+    if ((ok != legacyOk)
+        || ((! (p == legacy)) && (! bigEpoch) && (! hyphens))
+        || (LegacySplit(p.version) != Split(p.version))) {
+      if (! mismatches++) {
+        cerr << "mismatch: '" << s << "'\n";
+      }
+    }
+  }
+
+  size_t  n = versions.size();
+  size_t  sum = 0;
+  auto    start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (const auto & s : versions) {
+      Parsed  p;
+      sum += LegacyFromString(s, p);
+      sum += LegacySplit(p.version).size();
+    }
+  }
+  double  legacySecs = Seconds(start);
+
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (const auto & s : versions) {
+      Dwm::Deb::PkgVersion  v;
+      sum += v.FromString(s);
+      sum += Split(v.Version().String()).size();
+    }
+  }
+  double  newSecs = Seconds(start);
+
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (const auto & s : versions) {
+      Dwm::Deb::PkgVersion  v;
+      sum += v.FromString(s);
+    }
+  }
+  double  fromStringSecs = Seconds(start);
+
+  size_t  parses = n * iterations;
+  cout << "versions:      " << n << " (" << sum << ")\n"
+       << "legacy parse:  " << (legacySecs * 1e9) / parses
+       << " ns/version\n"
+       << "new parse:     " << (newSecs * 1e9) / parses
+       << " ns/version\n"
+       << "FromString():  " << (fromStringSecs * 1e9) / parses
+       << " ns/version (including the sort key)\n"
+       << "mismatches:    " << mismatches << " of " << n << '\n';
+  return (mismatches ? 1 : 0);
+}
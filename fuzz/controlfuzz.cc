@@ -0,0 +1,141 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file controlfuzz.cc
+//!  \author Daniel W. McRobb
+//!  \brief fuzz target for the control file parser: whatever it accepts
+//!    must print as a control file it parses back to the same thing
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "DwmDebControl.hh"
+#include "fuzzdriver.hh"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+//!  Writes @c s to a scratch file (the parser reads from a path) and
+//!  parses it into @c ctrl.  Returns false if the parse failed.  Syntax
+//!  errors go to stderr and the scanner echoes text it has no rule for
+//!  to stdout, so both point at /dev/null during the parse.
+//----------------------------------------------------------------------------
+static bool Parse(const string & s, Dwm::Deb::Control & ctrl)
+{
+  static string  path;
+  static int     devNull = -1;
+  if (path.empty()) {
+    char  tmpl[] = "/tmp/controlfuzz.XXXXXX";
+    int   fd = mkstemp(tmpl);
+    if (fd < 0) {
+      perror("mkstemp");
+      exit(1);
+    }
+    close(fd);
+    path = tmpl;
+    atexit([] { unlink(path.c_str()); });
+    devNull = open("/dev/null", O_WRONLY);
+  }
+  FILE  *f = fopen(path.c_str(), "w");
+  if (! f) {
+    perror(path.c_str());
+    exit(1);
+  }
+  fwrite(s.data(), 1, s.size(), f);
+  fclose(f);
+  fflush(stdout);
+  int  savedStdout = dup(STDOUT_FILENO);
+  int  savedStderr = dup(STDERR_FILENO);
+  dup2(devNull, STDOUT_FILENO);
+  dup2(devNull, STDERR_FILENO);
+  bool  rc = ctrl.Parse(path);
+  fflush(stdout);
+  dup2(savedStdout, STDOUT_FILENO);
+  dup2(savedStderr, STDERR_FILENO);
+  close(savedStdout);
+  close(savedStderr);
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  string             input((const char *)data, size);
+  Dwm::Deb::Control  ctrl;
+  if (input.find('\0') != string::npos) {
+    return 0;
+  }
+  if (Parse(input, ctrl)) {
+    ostringstream  printed;
+    printed << ctrl;
+    Dwm::Deb::Control  reparsed;
+    if (! Parse(printed.str(), reparsed)) {
+      FuzzDriver::Mismatch("printed control doesn't parse:\n"
+                           + printed.str());
+      return 0;
+    }
+    ostringstream  reprinted;
+    reprinted << reparsed;
+    if (reprinted.str() != printed.str()) {
+      FuzzDriver::Mismatch("control changed on reparse:\n" + printed.str()
+                           + "became:\n" + reprinted.str());
+    }
+  }
+  return 0;
+}
+
+#ifndef DWM_LIBFUZZER
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  return FuzzDriver::Main(argc, argv, "abcDPV:-,()<>= \t\n1.~|");
+}
+
+#endif
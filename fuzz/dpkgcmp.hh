@@ -0,0 +1,102 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file dpkgcmp.hh
+//!  \author Daniel W. McRobb
+//!  \brief compares versions with 'dpkg --compare-versions', for the
+//!    version fuzz target and benchmark
+//---------------------------------------------------------------------------
+
+#ifndef _DPKGCMP_HH_
+#define _DPKGCMP_HH_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DwmDebProcessRunner.hh"
+
+namespace DpkgCmp {
+
+  //--------------------------------------------------------------------------
+  //!  
+  //--------------------------------------------------------------------------
+  inline int Sign(int n)
+  {
+    return ((n > 0) - (n < 0));
+  }
+
+  //--------------------------------------------------------------------------
+  //!  Compares each of @c pairs with 'dpkg --compare-versions' (two runs
+  //!  each, for 'lt' and 'eq', through a Dwm::Deb::ProcessRunner) and
+  //!  fills @c signs with the sign of each comparison, or 2 where dpkg
+  //!  couldn't be run or rejected a version.  Returns false if the
+  //!  commands couldn't be run at all.
+  //--------------------------------------------------------------------------
+  inline bool
+  Compare(const std::vector<std::pair<std::string,std::string>> & pairs,
+          std::vector<int> & signs)
+  {
+    std::vector<Dwm::Deb::ProcessRunner::Command>  cmds;
+    for (const auto & p : pairs) {
+      for (const char *op : { "lt", "eq" }) {
+        cmds.push_back({{ "dpkg", "--compare-versions", p.first, op,
+                          p.second }, 10000});
+      }
+    }
+    std::vector<Dwm::Deb::ProcessRunner::Result>  results;
+    if (! Dwm::Deb::ProcessRunner().Run(cmds, results)) {
+      return false;
+    }
+    signs.clear();
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      const auto & lt = results[i * 2];
+      const auto & eq = results[(i * 2) + 1];
+      if ((! lt.exited) || (! eq.exited)
+          || (lt.exitStatus > 1) || (eq.exitStatus > 1)) {
+        signs.push_back(2);
+      }
+      else {
+        signs.push_back((lt.exitStatus == 0)
+                        ? -1 : ((eq.exitStatus == 0) ? 0 : 1));
+      }
+    }
+    return true;
+  }
+
+}  // namespace DpkgCmp
+
+#endif  // _DPKGCMP_HH_
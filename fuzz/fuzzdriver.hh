@@ -0,0 +1,286 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file fuzzdriver.hh
+//!  \author Daniel W. McRobb
+//!  \brief standalone driver for the fuzz targets: runs a corpus (and
+//!    optionally random mutations of it) through LLVMFuzzerTestOneInput()
+//!    and reports throughput and mismatches
+//---------------------------------------------------------------------------
+
+#ifndef _FUZZDRIVER_HH_
+#define _FUZZDRIVER_HH_
+
+extern "C" {
+  #include <dirent.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+}
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//  Each target defines this, with libFuzzer's signature.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace FuzzDriver {
+
+  //--------------------------------------------------------------------------
+  //!  Mismatches found so far.
+  //--------------------------------------------------------------------------
+  inline size_t  g_mismatches = 0;
+
+  //--------------------------------------------------------------------------
+  //!  Called by a target when the fast and reference implementations
+  //!  disagree.  Under libFuzzer we abort so the input is saved as a
+  //!  crash; otherwise the first few are printed and all are counted.
+  //--------------------------------------------------------------------------
+  inline void Mismatch(const std::string & what)
+  {
+#ifdef DWM_LIBFUZZER
+    std::cerr << "mismatch: " << what << '\n';
+    abort();
+#else
+    if (g_mismatches++ < 20) {
+      std::cerr << "mismatch: " << what << '\n';
+    }
+#endif
+  }
+
+  //--------------------------------------------------------------------------
+  //!  Appends the inputs in @c path to @c inputs: the whole file, each
+  //!  line (@c lines) or each pair of consecutive lines joined by a
+  //!  newline (@c pairs).  A directory contributes each regular file in
+  //!  it.  Returns false if @c path can't be read.
+  //--------------------------------------------------------------------------
+  inline bool LoadInputs(const std::string & path, bool lines, bool pairs,
+                         std::vector<std::string> & inputs)
+  {
+    struct stat  st;
+    if (stat(path.c_str(), &st) != 0) {
+      return false;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      DIR  *dir = opendir(path.c_str());
+      if (! dir) {
+        return false;
+      }
+      bool  rc = true;
+      while (struct dirent *de = readdir(dir)) {
+        if (de->d_name[0] != '.') {
+          rc &= LoadInputs(path + '/' + de->d_name, lines, pairs, inputs);
+        }
+      }
+      closedir(dir);
+      return rc;
+    }
+    std::ifstream  is(path, std::ios::binary);
+    if (! is) {
+      return false;
+    }
+    if (lines || pairs) {
+      std::string  line, prev;
+      bool         havePrev = false;
+      while (std::getline(is, line)) {
+        if (pairs) {
+          if (havePrev) {
+            inputs.push_back(prev + '\n' + line);
+          }
+          prev = line;
+          havePrev = true;
+        }
+        else {
+          inputs.push_back(line);
+        }
+      }
+    }
+    else {
+      std::ostringstream  os;
+      os << is.rdbuf();
+      inputs.push_back(os.str());
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  //!  Applies one to four random edits to @c s: replacing, inserting or
+  //!  deleting a byte (inserted bytes come from @c alphabet), or
+  //!  duplicating a chunk.
+  //--------------------------------------------------------------------------
+  inline void Mutate(std::string & s, std::mt19937 & rng,
+                     std::string_view alphabet)
+  {
+    int  edits = 1 + (rng() % 4);
+    for (int i = 0; i < edits; ++i) {
+      size_t  pos = (s.empty() ? 0 : (rng() % s.size()));
+      char    c = alphabet[rng() % alphabet.size()];
+      switch (rng() % 4) {
+        case 0:
+          if (! s.empty()) {
+            s[pos] = c;
+          }
+          break;
+        case 1:
+          s.insert(pos, 1, c);
+          break;
+        case 2:
+          if (! s.empty()) {
+            s.erase(pos, 1);
+          }
+          break;
+        default:
+          if (! s.empty()) {
+            size_t  len = 1 + (rng() % std::min<size_t>(8, s.size() - pos));
+            s.insert(pos, s.substr(pos, len));
+          }
+          break;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  //!  
+  //--------------------------------------------------------------------------
+  inline void Usage(const char *argv0, bool haveExtraCheck)
+  {
+    std::cerr << "usage: " << argv0
+              << " [-l|-p] [-m mutations] [-S seed]"
+              << (haveExtraCheck ? " [-d checks]" : "")
+              << " corpus_file_or_dir...\n"
+              << "  -l  each line of a corpus file is an input\n"
+              << "  -p  each pair of consecutive lines is an input\n"
+              << "  -m  also run this many random mutations of the corpus\n"
+              << "  -S  random seed for -m (default 1)\n";
+    if (haveExtraCheck) {
+      std::cerr << "  -d  also check up to this many inputs against dpkg\n";
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  //!  Returns the number of mismatches found by @c extraCheck in the
+  //!  first @c n of @c inputs.
+  //--------------------------------------------------------------------------
+  typedef size_t (*ExtraCheckFn)(const std::vector<std::string> & inputs,
+                                 size_t n);
+
+  //--------------------------------------------------------------------------
+  //!  main() for a standalone fuzz target.  Runs every corpus input and
+  //!  then any mutations through LLVMFuzzerTestOneInput(), then up to
+  //!  -d of the corpus inputs through @c extraCheck if given.  Prints
+  //!  throughput and mismatch counts; exits with 1 if there were any
+  //!  mismatches.
+  //--------------------------------------------------------------------------
+  inline int Main(int argc, char *argv[], std::string_view alphabet,
+                  ExtraCheckFn extraCheck = nullptr)
+  {
+    bool      lines = false, pairs = false;
+    size_t    mutations = 0, extraChecks = 0;
+    unsigned  seed = 1;
+    int       opt;
+    while ((opt = getopt(argc, argv, "d:lm:pS:")) != -1) {
+      switch (opt) {
+        case 'd':  extraChecks = std::stoul(optarg);   break;
+        case 'l':  lines = true;                       break;
+        case 'm':  mutations = std::stoul(optarg);     break;
+        case 'p':  pairs = true;                       break;
+        case 'S':  seed = std::stoul(optarg);          break;
+        default:
+          Usage(argv[0], extraCheck != nullptr);
+          return 1;
+      }
+    }
+    if ((optind >= argc) || (extraChecks && (! extraCheck))) {
+      Usage(argv[0], extraCheck != nullptr);
+      return 1;
+    }
+    std::vector<std::string>  inputs;
+    for (int i = optind; i < argc; ++i) {
+      if (! LoadInputs(argv[i], lines, pairs, inputs)) {
+        std::cerr << "failed to read " << argv[i] << '\n';
+        return 1;
+      }
+    }
+    if (inputs.empty()) {
+      inputs.push_back(std::string());
+    }
+
+    typedef std::chrono::steady_clock  Clock;
+    size_t  bytes = 0;
+    auto    start = Clock::now();
+    for (const auto & input : inputs) {
+      LLVMFuzzerTestOneInput((const uint8_t *)input.data(), input.size());
+      bytes += input.size();
+    }
+    std::mt19937  rng(seed);
+    std::string   mutated;
+    for (size_t i = 0; i < mutations; ++i) {
+      mutated = inputs[rng() % inputs.size()];
+      Mutate(mutated, rng, alphabet);
+      LLVMFuzzerTestOneInput((const uint8_t *)mutated.data(),
+                             mutated.size());
+      bytes += mutated.size();
+    }
+    double  secs =
+      std::chrono::duration<double>(Clock::now() - start).count();
+    size_t  runs = inputs.size() + mutations;
+    std::cout << "inputs:      " << inputs.size() << " corpus + "
+              << mutations << " mutated\n"
+              << "throughput:  " << (runs / secs) << " inputs/s, "
+              << (bytes / secs) / 1e6 << " MB/s\n"
+              << "mismatches:  " << g_mismatches << '\n';
+    size_t  extraMismatches = 0;
+    if (extraChecks) {
+      start = Clock::now();
+      extraChecks = std::min(extraChecks, inputs.size());
+      extraMismatches = extraCheck(inputs, extraChecks);
+      secs = std::chrono::duration<double>(Clock::now() - start).count();
+      std::cout << "dpkg checks: " << extraChecks << " in " << secs
+                << " s, " << extraMismatches << " mismatches\n";
+    }
+    return ((g_mismatches || extraMismatches) ? 1 : 0);
+  }
+
+}  // namespace FuzzDriver
+
+#endif  // _FUZZDRIVER_HH_
@@ -0,0 +1,243 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file versionfuzz.cc
+//!  \author Daniel W. McRobb
+//!  \brief differential fuzz target for version parsing and comparison:
+//!    PkgVersion, VersionString and FixedVersion against the reference
+//!    implementations in versionref.hh (and, standalone, against
+//!    'dpkg --compare-versions')
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "DwmDebFixedVersion.hh"
+#include "DwmDebPkgVersion.hh"
+#include "DwmDebVersionCompare.hh"
+#include "dpkgcmp.hh"
+#include "fuzzdriver.hh"
+#include "versionref.hh"
+
+using namespace std;
+using Dwm::Deb::FixedVersion, Dwm::Deb::PkgVersion, Dwm::Deb::VersionString;
+using DpkgCmp::Sign;
+
+//----------------------------------------------------------------------------
+//!  Returns @c s quoted, with control characters escaped.
+//----------------------------------------------------------------------------
+static string Quote(const string & s)
+{
+  static const char  hex[] = "0123456789abcdef";
+  string  rc("'");
+  for (unsigned char c : s) {
+    if ((c < 0x20) || (c == 0x7f) || (c == '\\')) {
+      rc += "\\x";
+      rc += hex[c >> 4];
+      rc += hex[c & 0xf];
+    }
+    else {
+      rc += c;
+    }
+  }
+  return rc + "'";
+}
+
+//----------------------------------------------------------------------------
+//!  Splits an input into the two versions to compare, at the first
+//!  newline.  Returns false for inputs outside the domain we check:
+//!  ones with NULs (the reference uses C strings) or non-ASCII bytes
+//!  (dpkg rejects them, and orders them by the signedness of char).
+//----------------------------------------------------------------------------
+static bool SplitInput(const string & input, string & a, string & b)
+{
+  for (unsigned char c : input) {
+    if ((c == 0) || (c > 0x7f)) {
+      return false;
+    }
+  }
+  size_t  nl = input.find('\n');
+  a = input.substr(0, nl);
+  b = ((nl == string::npos) ? string() : input.substr(nl + 1));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+//!  Parses @c s into @c v and @c ref.  Where the reference accepts @c s,
+//!  PkgVersion and FixedVersion must give it the same fields.  Returns
+//!  true if the reference accepted @c s.
+//----------------------------------------------------------------------------
+static bool CheckParse(const string & s, PkgVersion & v,
+                       VersionRef::Parsed & ref)
+{
+  bool  refOk = VersionRef::FromString(s, ref);
+  bool  ok = v.FromString(s);
+  if (refOk && ((! ok) || (v.Epoch() != ref.epoch)
+                || (v.Version().String() != ref.version)
+                || (v.Release() != ref.release))) {
+    FuzzDriver::Mismatch("FromString(" + Quote(s) + ")");
+  }
+  FixedVersion  fv;
+  if (fv.FromString(s)) {
+    if ((! ok) || (fv.Epoch() != v.Epoch())
+        || (fv.Version() != v.Version().String())
+        || (fv.Release() != v.Release())) {
+      FuzzDriver::Mismatch("FixedVersion(" + Quote(s) + ")");
+    }
+  }
+  return refOk;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void CheckCompare(const string & a, const string & b)
+{
+  PkgVersion          va, vb;
+  VersionRef::Parsed  ra, rb;
+  bool                refOk = CheckParse(a, va, ra);
+  refOk &= CheckParse(b, vb, rb);
+  string  what(Quote(a) + " vs " + Quote(b));
+
+  int  vs = Sign(VersionString(a).Compare(VersionString(b)));
+  if (vs != Sign(VersionRef::VerRevCmp(a.c_str(), b.c_str()))) {
+    FuzzDriver::Mismatch("VersionString " + what);
+  }
+  int  key = Sign(va.Compare(vb));
+  int  verrev =
+    Sign(Dwm::Deb::VersionCompare::Compare(va.Epoch(),
+                                           va.Version().String(),
+                                           va.Release(), vb.Epoch(),
+                                           vb.Version().String(),
+                                           vb.Release()));
+  if (key != verrev) {
+    FuzzDriver::Mismatch("PkgVersion " + what + ": key " + to_string(key)
+                         + ", VerRevCmp " + to_string(verrev));
+  }
+  if ((key == 0) && (hash<PkgVersion>()(va) != hash<PkgVersion>()(vb))) {
+    FuzzDriver::Mismatch("hash<PkgVersion> " + what);
+  }
+  if (! refOk) {
+    return;
+  }
+  int  ref = Sign(VersionRef::Compare(ra, rb));
+  if (key != ref) {
+    FuzzDriver::Mismatch("PkgVersion " + what + ": reference "
+                         + to_string(ref) + ", key " + to_string(key));
+  }
+  FixedVersion  fa, fb;
+  if (fa.FromString(a) && fb.FromString(b)) {
+    if ((Sign(fa.Compare(fb)) != ref) || (Sign(fa.Compare(vb)) != ref)) {
+      FuzzDriver::Mismatch("FixedVersion " + what);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  string  a, b;
+  if (SplitInput(string((const char *)data, size), a, b)) {
+    CheckCompare(a, b);
+  }
+  return 0;
+}
+
+#ifndef DWM_LIBFUZZER
+
+//----------------------------------------------------------------------------
+//!  Compares the first @c n of @c inputs with 'dpkg --compare-versions'
+//!  (two runs each, for 'lt' and 'eq').  Only pairs the reference
+//!  parser accepts are checked: dpkg rejects most of the rest as bad
+//!  syntax, and takes an empty argument to mean no version at all,
+//!  which orders before '~' where PkgVersion won't parse it.  Returns
+//!  the number of pairs PkgVersion orders differently.
+//----------------------------------------------------------------------------
+static size_t DpkgCheck(const vector<string> & inputs, size_t n)
+{
+  vector<pair<string,string>>  pairs;
+  for (size_t i = 0; i < n; ++i) {
+    string              a, b;
+    VersionRef::Parsed  ra, rb;
+    if (SplitInput(inputs[i], a, b) && VersionRef::FromString(a, ra)
+        && VersionRef::FromString(b, rb)) {
+      pairs.push_back({a, b});
+    }
+  }
+  vector<int>  signs;
+  if (! DpkgCmp::Compare(pairs, signs)) {
+    cerr << "failed to run dpkg\n";
+    return 1;
+  }
+  size_t  checked = 0, mismatches = 0;
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    int  dpkg = signs[i];
+    if (dpkg == 2) {
+      continue;
+    }
+    ++checked;
+    PkgVersion  va, vb;
+    va.FromString(pairs[i].first);
+    vb.FromString(pairs[i].second);
+    int  ours = Sign(va.Compare(vb));
+    if (ours != dpkg) {
+      if (mismatches++ < 20) {
+        cerr << "dpkg mismatch: " << Quote(pairs[i].first) << " vs "
+             << Quote(pairs[i].second) << ": dpkg " << dpkg
+             << ", PkgVersion " << ours << '\n';
+      }
+    }
+  }
+  cerr << checked << " of " << pairs.size()
+       << " pairs were valid versions to dpkg\n";
+  return mismatches;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  return FuzzDriver::Main(argc, argv, "0123456789.+-~:ab\n",
+                                    DpkgCheck);
+}
+
+#endif
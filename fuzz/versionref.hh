@@ -0,0 +1,197 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file versionref.hh
+//!  \author Daniel W. McRobb
+//!  \brief reference implementations of version parsing and comparison,
+//!    kept deliberately simple to check the fast ones against
+//---------------------------------------------------------------------------
+
+#ifndef _VERSIONREF_HH_
+#define _VERSIONREF_HH_
+
+#include <climits>
+#include <string>
+
+namespace VersionRef {
+
+  //--------------------------------------------------------------------------
+  //!  
+  //--------------------------------------------------------------------------
+  struct Parsed
+  {
+    int          epoch = 0;
+    std::string  version;
+    std::string  release;
+  };
+
+  //--------------------------------------------------------------------------
+  //!  dpkg's parseversion() from lib/dpkg/version.c: the epoch is before
+  //!  the first ':', the revision after the last '-'.  Returns false for
+  //!  the strings dpkg rejects (empty epoch, version or revision, or an
+  //!  epoch that isn't a number or doesn't fit an int), and for any
+  //!  with whitespace, since dpkg trims or rejects blanks where
+  //!  PkgVersion keeps them.  Epochs must be plain digits here, where
+  //!  dpkg's strtol() would also take a sign; no real version has one.
+  //!  PkgVersion::FromString() must give the same fields for every
+  //!  string this accepts.
+  //--------------------------------------------------------------------------
+  inline bool FromString(const std::string & s, Parsed & p)
+  {
+    p = Parsed();
+    if (s.empty() || (s.find_first_of(" \t\n\r\v\f") != s.npos)) {
+      return false;
+    }
+    std::string  rest = s;
+    size_t       colon = s.find(':');
+    if (colon != s.npos) {
+      std::string  epoch = s.substr(0, colon);
+      if (epoch.empty()
+          || (epoch.find_first_not_of("0123456789") != epoch.npos)) {
+        return false;
+      }
+      long long  e = 0;
+      for (char c : epoch) {
+        e = (e * 10) + (c - '0');
+        if (e > INT_MAX) {
+          return false;
+        }
+      }
+      p.epoch = static_cast<int>(e);
+      rest = s.substr(colon + 1);
+      if (rest.empty()) {
+        return false;
+      }
+    }
+    size_t  hyphen = rest.rfind('-');
+    if (hyphen != rest.npos) {
+      p.release = rest.substr(hyphen + 1);
+      if (p.release.empty()) {
+        return false;
+      }
+      rest.erase(hyphen);
+    }
+    p.version = rest;
+    return (! p.version.empty());
+  }
+
+  //--------------------------------------------------------------------------
+  //!  dpkg's order() from lib/dpkg/version.c.
+  //--------------------------------------------------------------------------
+  inline int Order(int c)
+  {
+    if ((c >= '0') && (c <= '9')) {
+      return 0;
+    }
+    else if (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z'))) {
+      return c;
+    }
+    else if (c == '~') {
+      return -1;
+    }
+    else if (c) {
+      return c + 256;
+    }
+    return 0;
+  }
+
+  //--------------------------------------------------------------------------
+  //!  dpkg's verrevcmp() from lib/dpkg/version.c, on NUL-terminated
+  //!  strings.  dpkg reads bytes as plain char, so callers should stick
+  //!  to ASCII for results that don't depend on its signedness.
+  //--------------------------------------------------------------------------
+  inline int VerRevCmp(const char *a, const char *b)
+  {
+    auto  isDigit = [] (int c) { return ((c >= '0') && (c <= '9')); };
+    while (*a || *b) {
+      int  firstDiff = 0;
+      while ((*a && (! isDigit(*a))) || (*b && (! isDigit(*b)))) {
+        int  ac = Order(*a);
+        int  bc = Order(*b);
+        if (ac != bc) {
+          return ac - bc;
+        }
+        a++;
+        b++;
+      }
+      while (*a == '0') {
+        a++;
+      }
+      while (*b == '0') {
+        b++;
+      }
+      while (isDigit(*a) && isDigit(*b)) {
+        if (! firstDiff) {
+          firstDiff = *a - *b;
+        }
+        a++;
+        b++;
+      }
+      if (isDigit(*a)) {
+        return 1;
+      }
+      if (isDigit(*b)) {
+        return -1;
+      }
+      if (firstDiff) {
+        return firstDiff;
+      }
+    }
+    return 0;
+  }
+
+  //--------------------------------------------------------------------------
+  //!  dpkg's dpkg_version_compare(): epoch, then upstream version, then
+  //!  revision.
+  //--------------------------------------------------------------------------
+  inline int Compare(const Parsed & a, const Parsed & b)
+  {
+    if (a.epoch > b.epoch) {
+      return 1;
+    }
+    if (a.epoch < b.epoch) {
+      return -1;
+    }
+    int  rc = VerRevCmp(a.version.c_str(), b.version.c_str());
+    if (rc) {
+      return rc;
+    }
+    return VerRevCmp(a.release.c_str(), b.release.c_str());
+  }
+
+}  // namespace VersionRef
+
+#endif  // _VERSIONREF_HH_
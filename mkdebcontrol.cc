@@ -42,8 +42,7 @@
 //---------------------------------------------------------------------------
 
 extern "C" {
-  #include <fts.h>
-  #include <signal.h>
+  #include <sys/stat.h>
   #include <strings.h>
   #include <unistd.h>
 }
@@ -52,27 +51,92 @@ extern "C" {
 #include <cctype>
 #include <cstring>
 #include <filesystem>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <regex>
 #include <set>
+#include <sstream>
+#include <vector>
 
 #include "DwmDebArguments.hh"
 #include "DwmDebControl.hh"
+#include "DwmDebElfBatchReader.hh"
+#include "DwmDebElfFile.hh"
+#include "DwmDebPackageIndex.hh"
+#include "DwmDebProcessRunner.hh"
+#include "DwmDebScanCache.hh"
+#include "DwmDebShlibDeps.hh"
+#include "DwmDebSonameResolver.hh"
+#include "DwmDebWorkStealingPool.hh"
+#ifdef __linux__
+  #include "DwmDebDirWalker.hh"
+#endif
 
 using namespace std;
 
 namespace fs = std::filesystem;
 
 typedef   Dwm::Deb::Arguments<Dwm::Deb::Argument<'a',string>,
+                              Dwm::Deb::Argument<'A',string>,
+                              Dwm::Deb::Argument<'c',string>,
                               Dwm::Deb::Argument<'d',string>,
+                              Dwm::Deb::Argument<'e',int>,
+                              Dwm::Deb::Argument<'H',bool>,
+                              Dwm::Deb::Argument<'j',int>,
                               Dwm::Deb::Argument<'m',string>,
+                              Dwm::Deb::Argument<'M',bool>,
                               Dwm::Deb::Argument<'n',string>,
                               Dwm::Deb::Argument<'r',string,true>,
+                              Dwm::Deb::Argument<'R',string>,
                               Dwm::Deb::Argument<'s',string,true>,
+                              Dwm::Deb::Argument<'u',bool>,
                               Dwm::Deb::Argument<'v',string>,
                               Dwm::Deb::Argument<'w',string>>  MyArgType;
 
-static MyArgType  g_args;
+//  The DT_NEEDED entries of one file, where the file asks for them to be
+//  looked for (DT_RUNPATH, or DT_RPATH if there's no DT_RUNPATH), and the
+//  file's Debian architecture (empty if unknown), which its libraries
+//  must match.
+struct FileNeeds
+{
+  string          dir;
+  vector<string>  needed;
+  string          searchPath;
+  string          arch;
+};
+
+//  What scanning tells us: what each file needs, the sonames of the
+//  shared objects we're packaging and, with -M, the symbols we use from
+//  each soname ('name@version').
+struct SharedLibRefs
+{
+  vector<FileNeeds>        files;
+  set<string>              sonames;
+  map<string,set<string>>  symbols;
+};
+
+#ifndef __linux__
+//  Scan candidates, keyed by (st_dev, st_ino) so that each physical file
+//  is only read once no matter how many names it has.
+typedef map<pair<dev_t,ino_t>,string>  CandidateMap;
+#else
+//  Scan candidates as found by Dwm::Deb::DirWalker, and what we learned
+//  about each of them.  Results are keyed by file rather than by name,
+//  since the name a file is examined under may not be the one we keep.
+typedef vector<pair<Dwm::Deb::DirWalker::FileId,string>>  CandidateList;
+typedef map<Dwm::Deb::DirWalker::FileId,Dwm::Deb::ScanCache::Entry>
+  ScanResults;
+#endif
+
+//  How long we let objdump or dpkg run before giving up on them.
+static const int  k_toolTimeoutMs = 60000;
+
+static MyArgType                g_args;
+static Dwm::Deb::ScanCache     g_scanCache;
+static Dwm::Deb::PackageIndex  g_pkgIndex;
 
 //----------------------------------------------------------------------------
 //!  
@@ -81,19 +145,53 @@ static void InitArgs()
 {
   g_args.SetValueName<'a'>("architecture");
   g_args.SetHelp<'a'>("Set the architecture");
+  g_args.SetValueName<'A'>("adminDirectory");
+  g_args.SetHelp<'A'>("Read the dpkg database in adminDirectory instead of"
+                      " sysroot/var/lib/dpkg.");
+  g_args.SetValueName<'c'>("cacheDirectory");
+  g_args.SetHelp<'c'>("Keep a cache of scan results in cacheDirectory, so"
+                      " that files which haven't changed since a previous"
+                      " run aren't read again.  An index of the dpkg"
+                      " database is kept there too.  The directory may be"
+                      " shared by concurrent mkdebcontrol processes.");
   g_args.SetValueName<'d'>("description");
   g_args.SetHelp<'d'>("Set the description");
+  g_args.SetValueName<'e'>("days");
+  g_args.SetHelp<'e'>("Remove scan cache (-c) entries that haven't been"
+                      " used for this many days.  Defaults to 30; 0 keeps"
+                      " them forever.");
+  g_args.Set<'e'>(30);
+  g_args.SetValueName<'j'>("jobs");
+  g_args.SetHelp<'j'>("Number of threads used to examine binaries and"
+                      " shared libraries.  Defaults to the number of"
+                      " online CPUs.");
+  g_args.Set<'j'>((int)Dwm::Deb::WorkStealingPool::OnlineCpus());
+  g_args.SetHelp<'H'>("When using a scan cache (-c), also verify a hash of"
+                      " each file's contents before using its cache"
+                      " entry.");
   g_args.SetValueName<'m'>("maintainer");
   g_args.SetHelp<'m'>("Set the maintainer");
+  g_args.SetHelp<'M'>("Depend on the minimal versions of shared library"
+                      " packages that provide the symbols we use, from"
+                      " the symbols and shlibs files in the dpkg info"
+                      " directory, instead of on the installed versions.");
   g_args.SetValueName<'n'>("name");
   g_args.SetHelp<'n'>("Set the package name");
   g_args.SetValueName<'r'>("debControlFile");
   g_args.SetHelp<'r'>("Read the given debControlFile and ingest its settings");
+  g_args.SetValueName<'R'>("sysroot");
+  g_args.SetHelp<'R'>("Resolve dependencies against the system installed"
+                      " in sysroot (its ld.so.cache, library directories"
+                      " and dpkg database) instead of this host.");
   g_args.SetValueName<'s'>("directory");
   g_args.SetHelp<'s'>("Staging directory where files to be packaged are"
                       " located.  Binaries and shared libraries are examined"
                       " in this directory (and its subdirectories,"
                       " recursively) to determine dependencies.");
+  g_args.SetHelp<'u'>("Read ELF headers in batches with io_uring, keeping"
+                      " many small reads in flight.  Helps cold-cache runs"
+                      " on large staging trees.  Falls back to pread() if"
+                      " io_uring is unavailable.  Linux only.");
   g_args.SetValueName<'v'>("version");
   g_args.SetHelp<'v'>("Set the package version");
   g_args.SetValueName<'w'>("URL");
@@ -101,43 +199,36 @@ static void InitArgs()
   return;
 }
 
-extern "C" {
-  //--------------------------------------------------------------------------
-  //!  
-  //--------------------------------------------------------------------------
-  void SigPipeHandler(int signum)
-  {
-    cerr << "got SIGPIPE\n";
-  }
-}
-
 //----------------------------------------------------------------------------
-//!  
+//!  The dpkg admin directory: -A, else the one in the sysroot (-R).
 //----------------------------------------------------------------------------
-static void HandleSigPipe()
+static string AdminDir()
 {
-  struct sigaction  action;
-  memset(&action,0,sizeof(action));
-  action.sa_handler = SigPipeHandler;
-  action.sa_flags   = 0;
-  if (sigaction(SIGPIPE, &action, nullptr) < 0) {
-    cerr << "Failed to install SIGPIPE handler\n";
+  if (! g_args.Get<'A'>().empty()) {
+    return g_args.Get<'A'>();
   }
-  return;
+  string  root = g_args.Get<'R'>();
+  while ((! root.empty()) && (root.back() == '/')) {
+    root.pop_back();
+  }
+  return root + "/var/lib/dpkg";
 }
 
 //----------------------------------------------------------------------------
-//!  
+//!  The name of the package index file in the cache directory.  Runs
+//!  against different dpkg databases may share a cache directory, so
+//!  the name includes a hash (FNV-1a) of the admin directory.
 //----------------------------------------------------------------------------
-static void SigPipeDefault()
+static string PackageIndexPath()
 {
-  struct sigaction  action;
-  memset(&action,0,sizeof(action));
-  action.sa_handler = SIG_DFL;
-  if (sigaction(SIGPIPE, &action, nullptr) < 0) {
-    cerr << "Failed to set default SIGPIPE handling\n";
+  uint64_t  hash = 0xcbf29ce484222325ULL;
+  for (char c : fs::absolute(AdminDir()).lexically_normal().string()) {
+    hash = (hash ^ (uint8_t)c) * 0x100000001b3ULL;
   }
-  return;
+  ostringstream  os;
+  os << g_args.Get<'c'>() << "/dpkg-index-" << hex << setfill('0')
+     << setw(16) << hash;
+  return os.str();
 }
 
 //----------------------------------------------------------------------------
@@ -151,79 +242,176 @@ static string ToLower(string s)
 }
               
 //----------------------------------------------------------------------------
-//!  
+//!  Fallback for ELF files that Dwm::Deb::ElfFile can't parse: let objdump
+//!  have a look.  Scanning threads may call this concurrently.  Returns
+//!  false if objdump couldn't be run, failed or timed out.
 //----------------------------------------------------------------------------
-static void GetSharedLibs(const string & filename, set<string> & libs)
-{
-  string  lddcmd("objdump -p " + filename);
-  lddcmd += " 2>/dev/null";
-  HandleSigPipe();
-  FILE    *lddpipe = popen(lddcmd.c_str(), "r");
-  if (lddpipe) {
-    regex   rgx("^[ \\t]+NEEDED[ \\t]+([^ \\t\\n]+)",
-                regex::ECMAScript|regex::optimize);
-    smatch  sm;
-    char    line[4096] = { '\0' };
-    while (fgets(line, 4096, lddpipe) != NULL) {
-      string  s(line);
-      if (regex_search(s, sm, rgx)) {
-        if (sm.size() == 2) {
-          string  lib(sm[1].str());
-          libs.insert(lib);
-        }
+static bool GetSharedLibsObjdump(const string & filename, set<string> & libs)
+{
+  Dwm::Deb::ProcessRunner          runner(1);
+  Dwm::Deb::ProcessRunner::Result  result;
+  if (! runner.Run({{"objdump", "-p", filename}, k_toolTimeoutMs}, result)) {
+    cerr << ("objdump failed on " + filename
+             + (result.timedOut ? " (timed out)\n" : "\n"));
+    return false;
+  }
+  regex   rgx("^[ \\t]+NEEDED[ \\t]+([^ \\t\\n]+)",
+              regex::ECMAScript|regex::optimize);
+  smatch  sm;
+  istringstream  is(result.output);
+  string         s;
+  while (getline(is, s)) {
+    if (regex_search(s, sm, rgx)) {
+      if (sm.size() == 2) {
+        string  lib(sm[1].str());
+        libs.insert(lib);
       }
-      memset(line, 0, sizeof(line));
     }
-    pclose(lddpipe);
   }
-  SigPipeDefault();
-  return;
+  return true;
 }
 
 //----------------------------------------------------------------------------
-//!  
+//!  Reads the DT_NEEDED entries of @c filename in-process, and with -M its
+//!  undefined dynamic symbols.  Files without the ELF magic number are
+//!  ignored; objdump would find nothing in them either.  Returns false if
+//!  we had to fall back to objdump and it failed, in which case @c entry
+//!  is incomplete and mustn't be cached.
 //----------------------------------------------------------------------------
-static string GetPackage(const string & shlib)
+static bool ReadSharedLibs(const string & filename,
+                           Dwm::Deb::ScanCache::Entry & entry)
 {
-  string  rc;
-  string  cmd("dpkg -S ");
-  cmd += shlib + " 2>/dev/null | tail -1";
-  HandleSigPipe();
-  FILE  *cmdpipe = popen(cmd.c_str(), "r");
-  if (cmdpipe) {
-    regex  rgx("([^:]+)[:].+", regex::ECMAScript|regex::optimize);
-    regex  rgxd("diversion by ([^ ]+) .+", regex::ECMAScript|regex::optimize);
-    smatch  sm;
-    char    line[4096] = { '\0' };
-    while (fgets(line, 4096, cmdpipe) != NULL) {
-      string  s(line);
-      if (regex_search(s, sm, rgxd)) {
-        if (sm.size() == 2) {
-          rc = sm[1].str();
-        }
+  entry = Dwm::Deb::ScanCache::Entry();
+  entry.haveSymbols = g_args.Get<'M'>();
+  Dwm::Deb::ElfFile  elf;
+  if (elf.Open(filename)) {
+    entry.needed.assign(elf.Needed().begin(), elf.Needed().end());
+    entry.soname = elf.Soname();
+    entry.rpath = elf.Rpath();
+    entry.runpath = elf.Runpath();
+    entry.arch = elf.Architecture();
+    if (entry.haveSymbols && elf.ReadUndefinedSymbols()) {
+      for (const auto & sym : elf.UndefinedSymbols()) {
+        entry.symbols.push_back({string(sym.name), string(sym.version),
+                                 string(sym.library)});
       }
-      else if (regex_search(s, sm, rgx)) {
-        if (sm.size() == 2) {
-          rc = sm[1].str();
-        }
+    }
+  }
+  else if (elf.IsElf()) {
+    set<string>  libs;
+    if (! GetSharedLibsObjdump(filename, libs)) {
+      return false;
+    }
+    entry.needed.assign(libs.begin(), libs.end());
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+//!  Adds what we learned about the file at @c path to @c refs.  A
+//!  versioned symbol names the library it's required from; an unversioned
+//!  one may come from any of the file's DT_NEEDED libraries.
+//----------------------------------------------------------------------------
+static void AddSharedLibRefs(const string & path,
+                             const Dwm::Deb::ScanCache::Entry & entry,
+                             SharedLibRefs & refs)
+{
+  if (! entry.soname.empty()) {
+    refs.sonames.insert(entry.soname);
+  }
+  if (! entry.needed.empty()) {
+    refs.files.push_back({fs::path(path).parent_path().string(),
+                          entry.needed,
+                          (entry.runpath.empty() ? entry.rpath
+                           : entry.runpath),
+                          entry.arch});
+  }
+  for (const auto & sym : entry.symbols) {
+    string  s = sym.name + '@' + (sym.version.empty() ? "Base" : sym.version);
+    if (! sym.library.empty()) {
+      refs.symbols[sym.library].insert(s);
+    }
+    else {
+      for (const auto & lib : entry.needed) {
+        refs.symbols[lib].insert(s);
       }
-      memset(line, 0, sizeof(line));
     }
-    pclose(cmdpipe);
   }
-  SigPipeDefault();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Gets the scan results for @c filename from the scan cache if we have
+//!  a current entry, else reads them from the file and updates the cache.
+//----------------------------------------------------------------------------
+static void GetScanEntry(const string & filename,
+                         Dwm::Deb::ScanCache::Entry & entry)
+{
+  Dwm::Deb::ScanCache::Key  key;
+  if (g_scanCache.IsOpen() && g_scanCache.GetKey(filename, key)) {
+    if (! g_scanCache.Get(key, entry, g_args.Get<'M'>())) {
+      if (ReadSharedLibs(filename, entry)) {
+        g_scanCache.Put(key, entry);
+      }
+    }
+  }
+  else {
+    ReadSharedLibs(filename, entry);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Extracts the package from the last line of 'dpkg -S' output.
+//----------------------------------------------------------------------------
+static string ParseDpkgSearch(const string & output)
+{
+  string  rc;
+  string  s(output);
+  while ((! s.empty()) && (s.back() == '\n')) {
+    s.pop_back();
+  }
+  s = s.substr(s.find_last_of('\n') + 1);
+  regex  rgx("([^:]+)[:].+", regex::ECMAScript|regex::optimize);
+  regex  rgxd("diversion by ([^ ]+) .+", regex::ECMAScript|regex::optimize);
+  smatch  sm;
+  if (regex_search(s, sm, rgxd)) {
+    if (sm.size() == 2) {
+      rc = sm[1].str();
+    }
+  }
+  else if (regex_search(s, sm, rgx)) {
+    if (sm.size() == 2) {
+      rc = sm[1].str();
+    }
+  }
   return rc;
 }
 
+//  'dpkg -S' answers, by path or soname.  Only used when the package
+//  index couldn't be loaded.
+static map<string,string>  g_dpkgSearches;
+
 //----------------------------------------------------------------------------
-//!  
+//!  Runs 'dpkg -S' for each of @c files we haven't already asked about,
+//!  -j at a time, and saves the answers for GetPackage().
 //----------------------------------------------------------------------------
-static void GetPackages(const set<string> & shlibs, set<string> & packages)
+static void PrefetchPackages(const set<string> & files)
 {
-  for (const auto & shlib : shlibs) {
-    string  pkg = GetPackage(shlib);
-    if (! pkg.empty()) {
-      packages.insert(pkg);
+  vector<string>                            toRun;
+  vector<Dwm::Deb::ProcessRunner::Command>  commands;
+  for (const auto & file : files) {
+    if (g_dpkgSearches.find(file) == g_dpkgSearches.end()) {
+      toRun.push_back(file);
+      commands.push_back({{"dpkg", "--admindir=" + AdminDir(), "-S", file},
+                          k_toolTimeoutMs});
+    }
+  }
+  Dwm::Deb::ProcessRunner                  runner(max(g_args.Get<'j'>(), 1));
+  vector<Dwm::Deb::ProcessRunner::Result>  results;
+  if (runner.Run(commands, results)) {
+    for (size_t i = 0; i < toRun.size(); ++i) {
+      g_dpkgSearches[toRun[i]] = ParseDpkgSearch(results[i].output);
     }
   }
   return;
@@ -232,28 +420,107 @@ static void GetPackages(const set<string> & shlibs, set<string> & packages)
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
-static void GetNeededPackages(const string & prog, set<string> & packages)
+static string GetPackage(const string & shlib)
 {
-  set<string>  shlibs;
-  GetSharedLibs(prog, shlibs);
-  GetPackages(shlibs, packages);
-  return;
+  auto  it = g_dpkgSearches.find(shlib);
+  if (it == g_dpkgSearches.end()) {
+    PrefetchPackages({shlib});
+    it = g_dpkgSearches.find(shlib);
+  }
+  return ((it != g_dpkgSearches.end()) ? it->second : string());
+}
+
+//----------------------------------------------------------------------------
+//!  Finds the package owning @c file, which is either a full path or a
+//!  bare file name, in g_pkgIndex.  If @c arch isn't empty, only packages
+//!  for that architecture are considered.  If several packages own it,
+//!  the first by name wins.  Falls back to 'dpkg -S' (which ignores
+//!  @c arch) if the index couldn't be loaded.
+//----------------------------------------------------------------------------
+static string LookupPackage(const string & file, const string & arch = "")
+{
+  if (! g_pkgIndex.IsLoaded()) {
+    return GetPackage(file);
+  }
+  string          rc;
+  vector<string>  owners;
+  if ((file.find('/') != string::npos)
+      ? g_pkgIndex.FindPath(file, owners, arch)
+      : g_pkgIndex.FindBasename(file, owners, arch)) {
+    //  Drop the multiarch qualifier.
+    rc = owners.front().substr(0, owners.front().find(':'));
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Finds the package for architecture @c arch owning the shared library
+//!  @c shlib.  We try the exact paths from @c resolver first, and only
+//!  fall back to matching the bare soname if no package owns any of
+//!  them.
+//----------------------------------------------------------------------------
+static string GetLibraryPackage(const Dwm::Deb::SonameResolver & resolver,
+                                const string & shlib, const string & arch)
+{
+  vector<string>  paths;
+  if (resolver.Resolve(shlib, paths)) {
+    for (const auto & path : paths) {
+      string  pkg = LookupPackage(path, arch);
+      if (! pkg.empty()) {
+        return pkg;
+      }
+    }
+  }
+  return LookupPackage(shlib, arch);
 }
 
 #ifndef __linux__
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
+static void MergeSharedLibRefs(SharedLibRefs & from, SharedLibRefs & to)
+{
+  to.files.insert(to.files.end(), make_move_iterator(from.files.begin()),
+                  make_move_iterator(from.files.end()));
+  to.sonames.merge(from.sonames);
+  for (auto & [lib, syms] : from.symbols) {
+    to.symbols[lib].merge(syms);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Adds @c path to @c paths unless we already have another name for the
+//!  same file.  When there are several names, the lexically smallest one
+//!  is kept so the choice doesn't depend on directory order.
+//----------------------------------------------------------------------------
+static void AddCandidate(const struct stat & st, const string & path,
+                         CandidateMap & paths)
+{
+  auto  [it, added] = paths.emplace(make_pair(st.st_dev, st.st_ino), path);
+  if ((! added) && (path < it->second)) {
+    it->second = path;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Collects the dynamically linked ELF objects under @c dirpath.  We
+//!  look at file contents rather than permissions: scripts and data files
+//!  with an exec bit are skipped, and shared objects installed without
+//!  one (as is common under usr/lib) are kept.
+//----------------------------------------------------------------------------
 static void GetExecutables(const std::string & dirpath,
-                           set<string> & paths)
+                           CandidateMap & paths)
 {
   try {
     for (auto & p : fs::recursive_directory_iterator(dirpath)) {
       if (fs::is_regular_file(p.path())) {
-        if ((fs::status(p.path()).permissions() & fs::perms::owner_exec)
-            != fs::perms::none) {
-          string  fp = p.path().string();
-          paths.insert(fp);
+        string       fp = p.path().string();
+        struct stat  st;
+        if ((stat(fp.c_str(), &st) == 0)
+            && Dwm::Deb::ElfFile::IsDynamicObject(fp)) {
+          AddCandidate(st, fp, paths);
         }
       }
     }
@@ -263,94 +530,490 @@ static void GetExecutables(const std::string & dirpath,
   }
 }
 
+//----------------------------------------------------------------------------
+//!  Examines all of the given @c executables concurrently, using the number
+//!  of threads given with -j.  Each worker collects into its own set and
+//!  the sets are merged at the end, so the result doesn't depend on the
+//!  order in which files were examined.
+//----------------------------------------------------------------------------
+static void GetSharedLibs(const CandidateMap & executables,
+                          SharedLibRefs & refs)
+{
+  Dwm::Deb::WorkStealingPool  pool(max(g_args.Get<'j'>(), 1));
+  vector<SharedLibRefs>       workerLibs(pool.NumThreads());
+  for (const auto & [inode, prog] : executables) {
+    pool.Submit([&prog,&workerLibs] (unsigned int worker)
+                {
+                  Dwm::Deb::ScanCache::Entry  entry;
+                  GetScanEntry(prog, entry);
+                  AddSharedLibRefs(prog, entry, workerLibs[worker]);
+                });
+  }
+  pool.Wait();
+  for (auto & wl : workerLibs) {
+    MergeSharedLibRefs(wl, refs);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void GetAllSharedLibs(const vector<string> & roots,
+                             SharedLibRefs & refs)
+{
+  CandidateMap  executables;
+  for (const auto & root : roots) {
+    cerr << "scanning " << root << '\n';
+    GetExecutables(root, executables);
+  }
+  GetSharedLibs(executables, refs);
+  return;
+}
+
 #else
 
+//  How many candidates we give each Dwm::Deb::ElfBatchReader with -u.
+static const size_t  k_batchSize = 128;
+
+//----------------------------------------------------------------------------
+//!  Reads the DT_NEEDED entries of all of the @c candidates with a
+//!  Dwm::Deb::ElfBatchReader, which also weeds out files that aren't
+//!  dynamically linked ELF objects, and saves them in @c results.  Files
+//!  with a current scan cache entry are skipped as soon as they're known
+//!  to be candidates.  Files the batch reader can't handle go through
+//!  ReadSharedLibs(), as do all candidates with -M since the batch reader
+//!  doesn't read symbols.
 //----------------------------------------------------------------------------
-//!  Sigh, std::filesystem is still broken in GNU libstdc++fs on Raspbian 10
-//!  (and probably on other Linux platforms).  On Raspbian 10 on the
-//!  Raspberry Pi 4, it stomps on the stack and results in a useless core
-//!  dump as a result.  valgrind isn't any help because it loses track.
-//!  gcc/g++ on Raspbian don't have stack protection options.  So...
-//!
-//!  xxx TODO: see if I can reproduce this in stdc++fs on Ubuntu 20.04.
-//!
-//!  Resort to using fts_open(, fts_read() and fts_close().  They're C
-//!  interfaces, but they're old and work correctly on Linux.
-//----------------------------------------------------------------------------
-static void GetExecutables(const string & dirName, set<string> & paths)
-{
-  string             filename;
-  char  *dirs[2] = { strdup(dirName.c_str()), 0 };
-  FTS  *fts = fts_open(&dirs[0], FTS_PHYSICAL|FTS_NOCHDIR, 0);
-  if (fts) {
-    FTSENT  *ftsent;
-    while ((ftsent = fts_read(fts))) {
-      switch (ftsent->fts_info) {
-        case FTS_F:
-          {
-            filename = ftsent->fts_path;
-            fs::path  p(filename);
-            if ((fs::status(p).permissions() & fs::perms::owner_exec)
-                != fs::perms::none) {
-              paths.insert(filename);
-            }
-          }
-          break;
-        default:
-          break;
+static void ReadSharedLibsBatch(const CandidateList & candidates,
+                                ScanResults & results,
+                                Dwm::Deb::ElfBatchReader::Stats & stats)
+{
+  using Dwm::Deb::ElfBatchReader;
+  using Dwm::Deb::ScanCache;
+
+  vector<string>  paths;
+  for (const auto & candidate : candidates) {
+    paths.push_back(candidate.second);
+  }
+  vector<ScanCache::Key>  keys(paths.size());
+  vector<bool>            haveKeys(paths.size(), false);
+  auto  checkCache = [&] (size_t i)
+  {
+    if (g_scanCache.IsOpen() && g_scanCache.GetKey(paths[i], keys[i])) {
+      haveKeys[i] = true;
+      ScanCache::Entry  entry;
+      if (g_scanCache.Get(keys[i], entry, g_args.Get<'M'>())) {
+        results[candidates[i].first] = move(entry);
+        return false;
+      }
+    }
+    return true;
+  };
+
+  ElfBatchReader                  reader(true);
+  vector<ElfBatchReader::Result>  readResults;
+  reader.Read(paths, readResults, checkCache);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    ScanCache::Entry  entry;
+    if ((readResults[i].status == ElfBatchReader::Status::Parsed)
+        && (! g_args.Get<'M'>())) {
+      entry.needed = readResults[i].needed;
+      entry.soname = readResults[i].soname;
+      entry.rpath = readResults[i].rpath;
+      entry.runpath = readResults[i].runpath;
+      entry.arch = readResults[i].arch;
+    }
+    else if ((readResults[i].status == ElfBatchReader::Status::Parsed)
+             || (readResults[i].status == ElfBatchReader::Status::Failed)) {
+      if (! ReadSharedLibs(paths[i], entry)) {
+        haveKeys[i] = false;
       }
     }
-    fts_close(fts);
+    else {
+      continue;
+    }
+    if (haveKeys[i]) {
+      g_scanCache.Put(keys[i], entry);
+    }
+    results[candidates[i].first] = move(entry);
   }
-  free(dirs[0]);
+  stats += reader.GetStats();
   return;
 }
-#endif
 
 //----------------------------------------------------------------------------
-//!  
+//!  Adds the scan results of all of the workers to @c refs, in name order.
+//!  Each file is added under the smallest name @c walker found for it, so
+//!  $ORIGIN expands the same way on every run.
+//----------------------------------------------------------------------------
+static void AddScanResults(const Dwm::Deb::DirWalker & walker,
+                           const vector<ScanResults> & workerResults,
+                           SharedLibRefs & refs)
+{
+  map<string,const Dwm::Deb::ScanCache::Entry *>  byName;
+  for (const auto & results : workerResults) {
+    for (const auto & [id, entry] : results) {
+      byName[walker.Name(id)] = &entry;
+    }
+  }
+  for (const auto & [name, entry] : byName) {
+    AddSharedLibRefs(name, *entry, refs);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  With -u: each worker collects the candidates the walker gives it into
+//!  a batch, and a full batch is read through its own
+//!  Dwm::Deb::ElfBatchReader while the walk goes on.  What's left in the
+//!  batches is read once the walk is done.
 //----------------------------------------------------------------------------
-void UpdateDepends(Dwm::Deb::Control & debctrl)
-{
-  if (! debctrl.Depends().empty()) {
-    set<pair<Dwm::Deb::PkgDepend,Dwm::Deb::PkgDepend>>  changeDeps;;
-    for (auto dep : debctrl.Depends()) {
-      auto  installedVers = Dwm::Deb::PkgDepend::InstalledVersion(dep.Package());
-      if (installedVers > dep.Version()) {
-        Dwm::Deb::PkgDepend  newDep = dep;
-        newDep.Version(installedVers);
-        newDep.Operator(">=");
-        changeDeps.insert({dep,newDep});
+static void GetAllSharedLibsBatched(const vector<string> & roots,
+                                    Dwm::Deb::WorkStealingPool & pool,
+                                    SharedLibRefs & refs)
+{
+  using Dwm::Deb::DirWalker;
+  using Dwm::Deb::ElfBatchReader;
+
+  vector<ScanResults>            workerResults(pool.NumThreads());
+  vector<ElfBatchReader::Stats>  workerStats(pool.NumThreads());
+  vector<CandidateList>          batches(pool.NumThreads());
+  auto  read = [&] (CandidateList & batch)
+  {
+    auto  b = make_shared<CandidateList>(move(batch));
+    batch.clear();
+    pool.Submit([b,&workerResults,&workerStats] (unsigned int worker)
+                { ReadSharedLibsBatch(*b, workerResults[worker],
+                                      workerStats[worker]); });
+  };
+  auto  collect = [&] (const string & path, const DirWalker::FileId & id,
+                       unsigned int worker)
+  {
+    batches[worker].emplace_back(id, path);
+    if (batches[worker].size() >= k_batchSize) {
+      read(batches[worker]);
+    }
+  };
+  DirWalker  walker(pool, collect);
+  walker.Walk(roots);
+  pool.Wait();
+  for (auto & batch : batches) {
+    if (! batch.empty()) {
+      read(batch);
+    }
+  }
+  pool.Wait();
+  AddScanResults(walker, workerResults, refs);
+  
+  ElfBatchReader::Stats  stats;
+  for (const auto & ws : workerStats) {
+    stats += ws;
+  }
+  cerr << (stats.ioUring ? "io_uring" : "pread") << ": " << stats.files
+       << " files, " << stats.reads << " reads, mean queue depth "
+       << stats.MeanDepth() << ", max queue depth " << stats.maxDepth
+       << '\n';
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Walks all of the @c roots with Dwm::Deb::DirWalker and examines each
+//!  dynamically linked ELF object as soon as the walker finds it, all on
+//!  one pool of -j threads.  Directories are read in parallel, and files
+//!  are never stat'ed unless the filesystem doesn't report d_type.  Each
+//!  worker collects into its own set of results, keyed by file, and the
+//!  sets are merged at the end by AddScanResults(), so the result doesn't
+//!  depend on the order in which files were found or examined.
+//----------------------------------------------------------------------------
+static void GetAllSharedLibs(const vector<string> & roots,
+                             SharedLibRefs & refs)
+{
+  using Dwm::Deb::DirWalker;
+  
+  Dwm::Deb::WorkStealingPool  pool(max(g_args.Get<'j'>(), 1));
+  for (const auto & root : roots) {
+    cerr << "scanning " << root << '\n';
+  }
+  if (g_args.Get<'u'>()) {
+    GetAllSharedLibsBatched(roots, pool, refs);
+  }
+  else {
+    vector<ScanResults>  workerResults(pool.NumThreads());
+    auto  examine = [&workerResults] (const string & path,
+                                      const DirWalker::FileId & id,
+                                      unsigned int worker)
+    {
+      if (Dwm::Deb::ElfFile::IsDynamicObject(path)) {
+        GetScanEntry(path, workerResults[worker][id]);
       }
+    };
+    DirWalker  walker(pool, examine);
+    walker.Walk(roots);
+    pool.Wait();
+    AddScanResults(walker, workerResults, refs);
+  }
+  return;
+}
+#endif
+
+//----------------------------------------------------------------------------
+//!  Returns a lower bound of the installed version for each package in
+//!  @c deps, except for the packages in @c minimal whose versions came
+//!  from symbols or shlibs files (-M) and packages that aren't installed.
+//----------------------------------------------------------------------------
+static vector<Dwm::Deb::PkgDepend>
+InstalledFloors(const Dwm::Deb::DependSet & deps, const set<string> & minimal)
+{
+  vector<Dwm::Deb::PkgDepend>  rc;
+  for (const auto & [pkg, range] : deps) {
+    if (minimal.count(pkg)) {
+      continue;
     }
-    for (auto & changeDep : changeDeps) {
-      debctrl.RemoveDepend(changeDep.first);
-      debctrl.AddDepend(changeDep.second);
+    auto  installedVers = Dwm::Deb::PkgDepend::InstalledVersion(pkg);
+    if (installedVers > Dwm::Deb::PkgVersion()) {
+      rc.push_back(Dwm::Deb::PkgDepend(pkg, ">=", installedVers));
     }
   }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Raises dependencies to the installed versions of their packages,
+//!  except for the packages in @c minimal whose versions came from
+//!  symbols or shlibs files (-M).  A dependency that already requires a
+//!  newer version is left alone.
+//----------------------------------------------------------------------------
+void UpdateDepends(Dwm::Deb::Control & debctrl, const set<string> & minimal)
+{
+  for (const auto & floor : InstalledFloors(debctrl.Depends(), minimal)) {
+    debctrl.AddDepend(floor);
+  }
   return;
 }
 
 //----------------------------------------------------------------------------
-//!  
+//!  Like UpdateDepends(), for Pre-Depends.
 //----------------------------------------------------------------------------
-void UpdatePreDepends(Dwm::Deb::Control & debctrl)
-{
-  if (! debctrl.PreDepends().empty()) {
-    set<pair<Dwm::Deb::PkgDepend,Dwm::Deb::PkgDepend>>  changeDeps;
-    for (auto dep : debctrl.PreDepends()) {
-      auto  installedVers =
-        Dwm::Deb::PkgDepend::InstalledVersion(dep.Package());
-      if (installedVers > dep.Version()) {
-        Dwm::Deb::PkgDepend  newDep = dep;
-        newDep.Version(installedVers);
-        newDep.Operator(">=");
-        changeDeps.insert({dep,newDep});
+void UpdatePreDepends(Dwm::Deb::Control & debctrl,
+                      const set<string> & minimal)
+{
+  for (const auto & floor : InstalledFloors(debctrl.PreDepends(), minimal)) {
+    debctrl.AddPreDepend(floor);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Prints an error for each package in @c deps that no version could
+//!  satisfy.  Returns true if there were none.
+//----------------------------------------------------------------------------
+static bool CheckSatisfiable(const string & field,
+                             const Dwm::Deb::DependSet & deps)
+{
+  vector<string>  pkgs;
+  if (deps.Unsatisfiable(pkgs)) {
+    for (const auto & pkg : pkgs) {
+      Dwm::Deb::VersionRange       range;
+      vector<Dwm::Deb::PkgDepend>  relations;
+      deps.Find(pkg, range);
+      range.Relations(pkg, relations);
+      cerr << field << " on " << pkg << " can't be satisfied:";
+      string  sep(" ");
+      for (const auto & rel : relations) {
+        cerr << sep << rel;
+        sep = ", ";
       }
+      cerr << '\n';
     }
-    for (auto & changeDep : changeDeps) {
-      debctrl.RemovePreDepend(changeDep.first);
-      debctrl.AddPreDepend(changeDep.second);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+//!  Returns true if @c path is @c dir or is inside @c dir.  Both must be
+//!  canonical.
+//----------------------------------------------------------------------------
+static bool IsWithin(const fs::path & path, const fs::path & dir)
+{
+  auto  [dirEnd, pathIt] = mismatch(dir.begin(), dir.end(),
+                                    path.begin(), path.end());
+  return (dirEnd == dir.end());
+}
+
+//----------------------------------------------------------------------------
+//!  Canonicalizes the staging directory and any additional directories
+//!  from the command line, and drops any that are the same as or inside
+//!  another one so nothing is walked twice.
+//----------------------------------------------------------------------------
+static vector<string> GetScanRoots(int argc, char *argv[])
+{
+  vector<string>  args(1, g_args.Get<'s'>());
+  args.insert(args.end(), argv, argv + argc);
+  
+  set<fs::path>  canonical;
+  for (const auto & arg : args) {
+    error_code  ec;
+    fs::path    cp = fs::canonical(arg, ec);
+    if (! ec) {
+      canonical.insert(cp);
+    }
+    else {
+      cerr << "Failed to resolve " << arg << ": " << ec.message() << '\n';
+    }
+  }
+  //  A directory sorts before everything inside it, so one pass will do.
+  vector<string>  rc;
+  fs::path        prev;
+  for (const auto & cp : canonical) {
+    if ((! prev.empty()) && IsWithin(cp, prev)) {
+      cerr << "skipping " << cp.string() << " (inside "
+           << prev.string() << ")\n";
+      continue;
+    }
+    rc.push_back(cp.string());
+    prev = cp;
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Returns the directories named by @c file's DT_RUNPATH or DT_RPATH, as
+//!  paths under the scan @c roots.  $ORIGIN is the file's own directory;
+//!  other absolute directories are looked for under each root, since
+//!  that's where they'll be when the package is installed.  Directories
+//!  using other dynamic string tokens, or reaching outside the roots via
+//!  $ORIGIN, can't be satisfied by the package and are left out.
+//----------------------------------------------------------------------------
+static vector<fs::path> GetSearchDirs(const FileNeeds & file,
+                                      const vector<string> & roots)
+{
+  static const string  tokens[] = { "${ORIGIN}", "$ORIGIN" };
+  
+  vector<fs::path>  rc;
+  size_t            b = 0;
+  while (b <= file.searchPath.size()) {
+    size_t  e = file.searchPath.find(':', b);
+    if (e == string::npos) {
+      e = file.searchPath.size();
+    }
+    string  dir = file.searchPath.substr(b, e - b);
+    b = e + 1;
+    bool    origin = false;
+    for (const auto & token : tokens) {
+      size_t  o;
+      while ((o = dir.find(token)) != string::npos) {
+        dir.replace(o, token.size(), file.dir);
+        origin = true;
+      }
+    }
+    if (dir.empty() || (dir[0] != '/') || (dir.find('$') != string::npos)) {
+      continue;
+    }
+    fs::path  dp = fs::path(dir).lexically_normal();
+    for (const auto & root : roots) {
+      if (! origin) {
+        rc.push_back((fs::path(root) / dp.relative_path()).lexically_normal());
+      }
+      else if (IsWithin(dp, root)) {
+        rc.push_back(dp);
+        break;
+      }
+    }
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Returns the DT_NEEDED entries in @c refs that the package doesn't
+//!  satisfy itself.  A library is satisfied by the package if one of the
+//!  shared objects we're packaging has it as its DT_SONAME, or if it's
+//!  found in one of the needing file's DT_RUNPATH/DT_RPATH directories
+//!  under the scan @c roots.  Those don't need a package lookup, and
+//!  looking them up would only find an unrelated (or older) installed
+//!  copy.
+//----------------------------------------------------------------------------
+static map<string,set<string>> GetExternalLibs(const SharedLibRefs & refs,
+                                               const vector<string> & roots)
+{
+  map<string,set<string>>  rc;
+  set<string>              packaged;
+  for (const auto & file : refs.files) {
+    vector<fs::path>  dirs;
+    if (! file.searchPath.empty()) {
+      dirs = GetSearchDirs(file, roots);
+    }
+    for (const auto & lib : file.needed) {
+      bool  found = (refs.sonames.find(lib) != refs.sonames.end());
+      for (auto it = dirs.begin(); (! found) && (it != dirs.end()); ++it) {
+        error_code  ec;
+        found = fs::exists(*it / lib, ec);
+      }
+      if (found) {
+        packaged.insert(lib);
+      }
+      else {
+        rc[lib].insert(file.arch);
+      }
+    }
+  }
+  for (const auto & lib : packaged) {
+    if (rc.find(lib) == rc.end()) {
+      cerr << lib << " is in the package\n";
+    }
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Finds the package providing each shared library in @c libs, for each
+//!  architecture it's needed for (usually just one).  With -M, the
+//!  dependency on each one is versioned from the symbols we use (in
+//!  @c refs) and its package's symbols or shlibs file when there is one,
+//!  and the package is added to @c minimal.  Otherwise the dependency is
+//!  unversioned, to be raised to the installed version by UpdateDepends().
+//----------------------------------------------------------------------------
+static void GetNeededDepends(const map<string,set<string>> & libs,
+                             const SharedLibRefs & refs,
+                             map<string,Dwm::Deb::PkgDepend> & depends,
+                             set<string> & minimal)
+{
+  Dwm::Deb::SonameResolver  resolver(g_args.Get<'R'>());
+  Dwm::Deb::ShlibDeps       shlibDeps(AdminDir() + "/info");
+  const set<string>         noSymbols;
+  if (! g_pkgIndex.IsLoaded()) {
+    //  Ask dpkg about everything GetLibraryPackage() might, in parallel.
+    set<string>  files;
+    for (const auto & [shlib, archs] : libs) {
+      vector<string>  paths;
+      resolver.Resolve(shlib, paths);
+      files.insert(shlib);
+      files.insert(paths.begin(), paths.end());
+    }
+    PrefetchPackages(files);
+  }
+  for (const auto & [shlib, archs] : libs) {
+    for (const auto & arch : archs) {
+      string  pkg = GetLibraryPackage(resolver, shlib, arch);
+      if (pkg.empty()) {
+        continue;
+      }
+      Dwm::Deb::PkgDepend  dep(pkg);
+      if (g_args.Get<'M'>()) {
+        auto  syms = refs.symbols.find(shlib);
+        if (shlibDeps.GetDepend(pkg, shlib, arch,
+                                ((syms != refs.symbols.end())
+                                 ? syms->second : noSymbols), dep)) {
+          minimal.insert(dep.Package());
+        }
+      }
+      //  Several libraries may come from the same package; keep the
+      //  highest version.
+      auto  [it, added] = depends.emplace(dep.Package(), dep);
+      if ((! added) && (dep.Version() > it->second.Version())) {
+        it->second = dep;
+      }
     }
   }
   return;
@@ -360,21 +1023,29 @@ void UpdatePreDepends(Dwm::Deb::Control & debctrl)
 //!  
 //----------------------------------------------------------------------------
 static void GetAllNeededPackages(int argc, char *argv[],
-                                 set<string> & neededPackages)
+                                 map<string,Dwm::Deb::PkgDepend> & depends,
+                                 set<string> & minimal)
 {
-  set<string>  executables;
-  cerr << "scanning " << g_args.Get<'s'>() << '\n';
-  GetExecutables(g_args.Get<'s'>(), executables);
-  
-  for (int i = 0; i < argc; ++i) {
-    cerr << "scanning " << argv[i] << '\n';
-    GetExecutables(argv[i], executables);
+  //  Load the package index while we scan.  With a cache directory,
+  //  the index is kept there between runs.
+  auto  indexLoaded = async(launch::async, [] {
+    string  infoDir = AdminDir() + "/info";
+    return (g_args.Get<'c'>().empty()
+            ? g_pkgIndex.Load(infoDir)
+            : g_pkgIndex.Load(infoDir, PackageIndexPath()));
+  });
+  vector<string>  roots = GetScanRoots(argc, argv);
+  SharedLibRefs   refs;
+  GetAllSharedLibs(roots, refs);
+  if (! indexLoaded.get()) {
+    cerr << "Failed to load the dpkg package index, using dpkg -S\n";
   }
-  set<string>  sharedLibs;
-  for (const auto & prog : executables) {
-    GetSharedLibs(prog, sharedLibs);
+  if (g_scanCache.IsOpen()) {
+    uint64_t  evicted = g_scanCache.Evict();
+    cerr << "scan cache: " << g_scanCache.Hits() << " hits, "
+         << g_scanCache.Misses() << " misses, " << evicted << " evicted\n";
   }
-  GetPackages(sharedLibs, neededPackages);
+  GetNeededDepends(GetExternalLibs(refs, roots), refs, depends, minimal);
   return;
 }
 
@@ -418,6 +1089,17 @@ int main(int argc, char *argv[])
     exit(1);
   }
   
+  if (! g_args.Get<'c'>().empty()) {
+    if (! g_scanCache.Open(g_args.Get<'c'>(), g_args.Get<'H'>(),
+                           max(g_args.Get<'e'>(), 0))) {
+      cerr << "Failed to open scan cache directory '" << g_args.Get<'c'>()
+           << "'\n";
+      exit(1);
+    }
+  }
+  
+  Deb::PkgDepend::AdminDir(AdminDir());
+  
   Deb::Control  debctrl;
   if (debctrl.Parse(g_args.Get<'r'>())) {
     ApplyCommandLineSettings(debctrl);
@@ -426,17 +1108,23 @@ int main(int argc, char *argv[])
       exit(1);
     }
     auto  pkgit = debctrl.Entries().find("Package:");
-    set<string>  neededPackages;
-    GetAllNeededPackages(argc - arg, &(argv[arg]), neededPackages);
-    for (const auto & np : neededPackages) {
+    map<string,Deb::PkgDepend>  neededPackages;
+    set<string>                 minimal;
+    GetAllNeededPackages(argc - arg, &(argv[arg]), neededPackages, minimal);
+    for (const auto & [np, dep] : neededPackages) {
       //  Don't include our own package
       if (ToLower(np) != ToLower(pkgit->second)) {
-        debctrl.AddPreDepend(np);
-        debctrl.AddDepend(np);
+        debctrl.AddPreDepend(dep);
+        debctrl.AddDepend(dep);
       }
     }
-    UpdatePreDepends(debctrl);
-    UpdateDepends(debctrl);
+    UpdatePreDepends(debctrl, minimal);
+    UpdateDepends(debctrl, minimal);
+    bool  satisfiable = CheckSatisfiable("Pre-Depends", debctrl.PreDepends());
+    satisfiable &= CheckSatisfiable("Depends", debctrl.Depends());
+    if (! satisfiable) {
+      exit(1);
+    }
 
     //  Add previous versions of our package as a conflict
     auto    versit = debctrl.Entries().find("Version:");